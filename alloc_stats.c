@@ -0,0 +1,163 @@
+#define _GNU_SOURCE
+#include "alloc_stats.h"
+#include "utils.h"
+#include <malloc.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+
+#define CACHE_LINE 64
+#define MAX_SLOTS 1024
+// Keeps the user pointer 16-byte aligned.
+#define HEADER_SIZE 16
+
+typedef struct header_t header_t;
+typedef struct slot_t slot_t;
+
+struct header_t {
+  size_t size;
+  // Zero until the block is retired, then the time of the retire.
+  volatile uint64_t retired_ns;
+};
+
+// Counters are sharded per thread so the allocation path never contends.
+// Frees may happen on a different thread to the allocation, so a single
+// slot can go negative; only the sum across slots is meaningful.
+struct slot_t {
+  int64_t allocated, freed, retired, reclaimed;
+  histogram_t *retire_wait;
+} __attribute__((aligned(CACHE_LINE)));
+
+static bool enabled = false;
+static slot_t slots[MAX_SLOTS];
+static uint32_t next_slot = 0;
+// Slots of exited threads, handed to the next threads that start.
+static uint32_t free_slots[MAX_SLOTS];
+static uint32_t num_free = 0;
+static pthread_mutex_t free_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_key_t slot_key;
+static pthread_once_t slot_key_once = PTHREAD_ONCE_INIT;
+static __thread slot_t *my_slot = NULL;
+// Whether this thread is the only one using my_slot, and so may write
+// its single-writer histogram.
+static __thread bool owns_slot = false;
+static __thread int64_t my_retires = 0;
+
+static void release_slot(void *slot) {
+  pthread_mutex_lock(&free_lock);
+  free_slots[num_free++] = (slot_t*)slot - slots;
+  pthread_mutex_unlock(&free_lock);
+}
+
+static void create_slot_key() {
+  pthread_key_create(&slot_key, release_slot);
+}
+
+static slot_t * get_slot() {
+  if(my_slot == NULL) {
+    pthread_once(&slot_key_once, create_slot_key);
+    pthread_mutex_lock(&free_lock);
+    if(num_free > 0) {
+      my_slot = &slots[free_slots[--num_free]];
+      owns_slot = true;
+    } else if(next_slot < MAX_SLOTS) {
+      my_slot = &slots[next_slot++];
+      my_slot->retire_wait = histogram_create();
+      owns_slot = true;
+    } else {
+      // Past MAX_SLOTS live threads, share a slot.  The counters are
+      // updated atomically, so that is still correct, but only the owner
+      // records wait times.
+      my_slot = &slots[next_slot++ % MAX_SLOTS];
+    }
+    pthread_mutex_unlock(&free_lock);
+    if(owns_slot) { pthread_setspecific(slot_key, my_slot); }
+  }
+  return my_slot;
+}
+
+static header_t * header_of(void *ptr) {
+  return (header_t*)((char*)ptr - HEADER_SIZE);
+}
+
+void alloc_stats_enable() {
+  enabled = true;
+}
+
+void * alloc_stats_malloc(size_t size) {
+  char *base = malloc(size + HEADER_SIZE);
+  if(base == NULL) { return NULL; }
+  header_t *header = (header_t*)base;
+  header->size = malloc_usable_size(base) - HEADER_SIZE;
+  header->retired_ns = 0;
+  __sync_fetch_and_add(&get_slot()->allocated, header->size);
+  return base + HEADER_SIZE;
+}
+
+void alloc_stats_free(void *ptr) {
+  if(ptr == NULL) { return; }
+  header_t *header = header_of(ptr);
+  slot_t *slot = get_slot();
+  __sync_fetch_and_add(&slot->freed, header->size);
+  uint64_t retired_ns = header->retired_ns;
+  if(retired_ns != 0) {
+    __sync_fetch_and_add(&slot->reclaimed, header->size);
+    // Histograms are single-writer, so shared slots skip the wait time.
+    if(owns_slot) {
+      histogram_record(slot->retire_wait, clock_ns() - retired_ns);
+    }
+  }
+  free(header);
+}
+
+size_t alloc_stats_usable_size(void *ptr) {
+  return header_of(ptr)->size;
+}
+
+void alloc_stats_retire(void *ptr) {
+  if(!enabled || ptr == NULL) { return; }
+  header_t *header = header_of(ptr);
+  header->retired_ns = clock_ns();
+  slot_t *slot = get_slot();
+  __sync_fetch_and_add(&slot->retired, header->size);
+  my_retires++;
+}
+
+static int64_t sum(size_t offset) {
+  int64_t total = 0;
+  for(uint32_t i = 0; i < MAX_SLOTS; i++) {
+    total += *(volatile int64_t*)((char*)&slots[i] + offset);
+  }
+  return total;
+}
+
+int64_t alloc_stats_retired_bytes() {
+  return sum(offsetof(slot_t, retired)) - sum(offsetof(slot_t, reclaimed));
+}
+
+int64_t alloc_stats_live_bytes() {
+  return sum(offsetof(slot_t, allocated)) - sum(offsetof(slot_t, freed))
+    - alloc_stats_retired_bytes();
+}
+
+/** Number of retires issued by the calling thread.
+ */
+int64_t alloc_stats_thread_retires() {
+  return my_retires;
+}
+
+void alloc_stats_merge_retire_wait(histogram_t *into) {
+  for(uint32_t i = 0; i < MAX_SLOTS; i++) {
+    if(slots[i].retire_wait != NULL) {
+      histogram_merge(into, slots[i].retire_wait);
+    }
+  }
+}
+
+int64_t peak_rss_bytes() {
+  struct rusage usage;
+  if(getrusage(RUSAGE_SELF, &usage) != 0) { return 0; }
+  // ru_maxrss is reported in kilobytes on Linux.
+  return (int64_t)usage.ru_maxrss * 1024;
+}
@@ -0,0 +1,26 @@
+/* Allocation accounting for the benchmark allocator hook.
+ * When enabled, alloc_stats_malloc/free/usable_size are handed to
+ * forkscan_set_allocator and every block carries a small header recording
+ * its size and when it was retired.  The data structures call
+ * alloc_stats_retire just before retiring a node so that memory awaiting
+ * reclamation can be told apart from memory still in use, and so the time a
+ * node waits between retire and free can be measured.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "histogram.h"
+
+void alloc_stats_enable();
+void * alloc_stats_malloc(size_t size);
+void alloc_stats_free(void *ptr);
+size_t alloc_stats_usable_size(void *ptr);
+void alloc_stats_retire(void *ptr);
+
+int64_t alloc_stats_live_bytes();
+int64_t alloc_stats_retired_bytes();
+int64_t alloc_stats_thread_retires();
+void alloc_stats_merge_retire_wait(histogram_t *into);
+int64_t peak_rss_bytes();
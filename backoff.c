@@ -0,0 +1,79 @@
+#include "backoff.h"
+#include <sched.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define cpu_relax() _mm_pause()
+#else
+#define cpu_relax() __asm__ __volatile__("" ::: "memory")
+#endif
+
+// The first exponential window, and the fixed spin of the pause policy.
+#define MIN_SPINS 4
+
+enum { BACKOFF_NONE, BACKOFF_PAUSE, BACKOFF_EXP, BACKOFF_YIELD };
+
+static const char *policies[] = { "none", "pause", "exp", "yield" };
+
+static int policy = BACKOFF_NONE;
+static uint32_t max_window = 1024;
+
+// A window of 0 means no failure yet in this operation.
+static __thread uint32_t window = 0;
+static __thread uint64_t seed = 0;
+
+static uint64_t fast_rand() {
+  if(seed == 0) {
+    // Thread-local addresses differ, so threads start out of step.
+    seed = (uintptr_t)&seed | 1;
+  }
+  seed ^= seed << 6;
+  seed ^= seed >> 21;
+  seed ^= seed << 7;
+  return seed;
+}
+
+/** Select the policy by name for every thread.  Return -1 if there is no
+ *  such policy.
+ */
+int backoff_select(const char *name, int32_t max_spins) {
+  for(size_t i = 0; i < sizeof(policies) / sizeof(policies[0]); i++) {
+    if(strcmp(name, policies[i]) == 0) {
+      policy = i;
+      max_window = max_spins < MIN_SPINS ? MIN_SPINS : max_spins;
+      return 0;
+    }
+  }
+  return -1;
+}
+
+const char * backoff_policy() {
+  return policies[policy];
+}
+
+void backoff_cas_failure() {
+  switch(policy) {
+  case BACKOFF_NONE:
+    return;
+  case BACKOFF_PAUSE:
+    for(int i = 0; i < MIN_SPINS; i++) { cpu_relax(); }
+    return;
+  case BACKOFF_EXP: {
+    window = window == 0 ? MIN_SPINS : window;
+    uint32_t spins = 1 + fast_rand() % window;
+    for(uint32_t i = 0; i < spins; i++) { cpu_relax(); }
+    if(window < max_window) {
+      window = 2 * window > max_window ? max_window : 2 * window;
+    }
+    return;
+  }
+  case BACKOFF_YIELD:
+    sched_yield();
+    return;
+  }
+}
+
+void backoff_reset() {
+  window = 0;
+}
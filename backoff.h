@@ -0,0 +1,21 @@
+/* Contention management for the CAS retry loops in the data structures.
+ * Each structure calls backoff_cas_failure() after a failed CAS and before
+ * it retries.  What that does is picked at run time for the whole process:
+ *   none  - retry at once, as the structures always have;
+ *   pause - spin a few PAUSE instructions;
+ *   exp   - bounded exponential backoff: spin a random number of PAUSEs
+ *           under a window that doubles with each failure in the same
+ *           operation, up to max_spins;
+ *   yield - sched_yield, so a preempted thread that won the CAS can run
+ *           when there are more threads than cores.
+ * The benchmarks call backoff_reset() as each operation starts.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+int backoff_select(const char *policy, int32_t max_spins);
+const char * backoff_policy();
+void backoff_cas_failure();
+void backoff_reset();
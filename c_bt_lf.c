@@ -1,4 +1,6 @@
 #include "c_bt_lf.h"
+#include "contention_hooks.h"
+#include "backoff.h"
 #include <assert.h>
 #include <stdio.h>
 #include <forkscan.h>
@@ -116,8 +118,10 @@ static void seek(c_bt_lf_t * set, seek_record_t * sr, int64_t key){
     volatile node_t * parent_field = sr->parent->left;
     volatile node_t * current_field = sr->leaf->left;
     volatile node_t * current = node_address(current_field);
+    int64_t traversed = 0;
 
     while(current != NULL){
+        traversed++;
         if(!node_is_tagged(parent_field)){
             sr->ancestor = sr->parent;
             sr->successor = sr->leaf;
@@ -132,6 +136,7 @@ static void seek(c_bt_lf_t * set, seek_record_t * sr, int64_t key){
         }
         current = node_address(current_field);
     }
+    contention_traversed(traversed);
 }
 
 static bool cleanup(c_bt_lf_t * set, seek_record_t *sr, int64_t key) {
@@ -169,6 +174,11 @@ static bool cleanup(c_bt_lf_t * set, seek_record_t *sr, int64_t key) {
     bool result = __sync_bool_compare_and_swap(successor_address,
         node_address(successor),
         node_flag(unpacked_sibbling.address, unpacked_sibbling.flagged));
+    if(result) {
+        contention_snipped(1);
+    } else {
+        contention_cas_failure();
+    }
     return result;
 }
 
@@ -201,6 +211,8 @@ int c_bt_lf_add(c_bt_lf_t *set, int64_t key) {
             if(result) {
                 return true;
             } else {
+                contention_cas_failure();
+                backoff_cas_failure();
                 if(key < leaf_key) {
                     forkscan_free((void *)internal_node->left);
                 } else {
@@ -250,6 +262,8 @@ int c_bt_lf_remove_leaky(c_bt_lf_t * set, int64_t key) {
                     return true;
                 }
             } else {
+                contention_cas_failure();
+                backoff_cas_failure();
                 node_unpacked_t unpacked_node = c_bt_lf_node_unpack(*child_address);
                 if(unpacked_node.address == leaf &&
                     (unpacked_node.flagged || unpacked_node.tagged)){
@@ -267,4 +281,19 @@ int c_bt_lf_remove_leaky(c_bt_lf_t * set, int64_t key) {
             }
         }
     }
-}
\ No newline at end of file
+}
+
+// micro_bench hook only; not part of the set API.
+uint64_t c_bt_lf_micro_pack_unpack(const uint64_t *words, int64_t n) {
+    uint64_t sum = 0;
+    for(int64_t i = 0; i < n; i++) {
+        uint64_t word = words[i];
+        node_ptr packed = node_pack((node_ptr)word, (word & 0x4) != 0,
+                                    (word & 0x8) != 0);
+        node_unpacked_t unpacked = c_bt_lf_node_unpack(packed);
+        sum += (uint64_t)unpacked.address;
+        if(unpacked.flagged) { sum += 1; }
+        if(unpacked.tagged) { sum += 2; }
+    }
+    return sum;
+}
@@ -15,4 +15,7 @@ c_bt_lf_t * c_bt_lf_create();
 
 int c_bt_lf_contains(c_bt_lf_t * set, int64_t key);
 int c_bt_lf_add(c_bt_lf_t * set, int64_t key);
-int c_bt_lf_remove_leaky(c_bt_lf_t * set, int64_t key);
\ No newline at end of file
+int c_bt_lf_remove_leaky(c_bt_lf_t * set, int64_t key);
+
+// micro_bench hook only; not part of the set API.
+uint64_t c_bt_lf_micro_pack_unpack(const uint64_t *words, int64_t n);
@@ -3,6 +3,9 @@
  */
 
 #include "c_fhsl_lf.h"
+#include "alloc_stats.h"
+#include "contention_hooks.h"
+#include "backoff.h"
 
 #include <stdatomic.h>
 #include <stdbool.h>
@@ -78,16 +81,20 @@ c_fhsl_lf_t * c_fhsl_lf_create() {
  */
 int c_fhsl_lf_contains(c_fhsl_lf_t *set, int64_t key) {
   node_ptr node = &set->head;
+  int64_t traversed = 0;
   for(int64_t i = N - 1; i >= 0; i--) {
     node_ptr next = node_unmark(atomic_load_explicit(&node->next[i], memory_order_consume));
     while(next->key <= key) {
       node = next; 
       next = node_unmark(atomic_load_explicit(&node->next[i], memory_order_consume));
+      traversed++;
     }
     if(node->key == key) {
+      contention_traversed(traversed);
       return !node_is_marked(atomic_load_explicit(&node->next[0], memory_order_relaxed));
     }
   }
+  contention_traversed(traversed);
   return false;
 }
 
@@ -114,6 +121,7 @@ static int32_t random_level (uint64_t *seed, int32_t max) {
 static bool find(c_fhsl_lf_t *set, int64_t key, 
   node_ptr preds[N], node_ptr succs[N]) {
   bool marked, snip;
+  int64_t traversed = 0;
   // node_ptr pred = NULL, curr = NULL, succ = NULL;
 retry:
   while(true) {
@@ -121,8 +129,12 @@ retry:
     for(int64_t level = N - 1; level >= BOTTOM; --level) {
       node_ptr left_next = atomic_load_explicit(&left->next[level], memory_order_consume);
       // Is our current node invalid?
-      if(node_is_marked(left_next)) { goto retry; }
+      if(node_is_marked(left_next)) {
+        contention_restart();
+        goto retry;
+      }
       node_ptr right = left_next;
+      int64_t skipped = 0;
       // Find two nodes to put into preds and succs.
       while(true) {
         // Scan to the right so long as we find deleted nodes.
@@ -130,26 +142,38 @@ retry:
         while(node_is_marked(right_next)) {
           right = node_unmark(right_next);
           right_next = atomic_load_explicit(&right->next[level], memory_order_consume);
+          skipped++;
         }
+        traversed++;
         // Has the right not gone far enough?        
         if(right->key < key) {
           left = right;
           left_next = right_next;
           right = right_next;
+          traversed += skipped;
+          skipped = 0;
         } else {
           // Right node is greater than our key, he's our succ, break.
           break;
         }
       }
+      traversed += skipped;
       // Ensure the left node points to the right node, they must be adjacent.
       if(left_next != right) {
         bool success = atomic_compare_exchange_weak_explicit(&left->next[level], &left_next, right,
           memory_order_release, memory_order_relaxed);
-        if(!success) { goto retry; }
+        if(!success) {
+          contention_cas_failure();
+          backoff_cas_failure();
+          contention_restart();
+          goto retry;
+        }
+        contention_snipped(skipped);
       }
       preds[level] = left;
       succs[level] = right;
     }
+    contention_traversed(traversed);
     return succs[BOTTOM]->key == key;
   }
 }
@@ -171,6 +195,8 @@ int c_fhsl_lf_add(uint64_t *seed, c_fhsl_lf_t * set, int64_t key) {
     }
     node_ptr pred = preds[BOTTOM], succ = succs[BOTTOM];
     if(!atomic_compare_exchange_weak_explicit(&pred->next[BOTTOM], &succ, node, memory_order_release, memory_order_relaxed)) {
+      contention_cas_failure();
+      backoff_cas_failure();
       continue;
     }
     for(int64_t i = 1; i <= toplevel; i++) {
@@ -180,6 +206,8 @@ int c_fhsl_lf_add(uint64_t *seed, c_fhsl_lf_t * set, int64_t key) {
           &succ, node, memory_order_release, memory_order_relaxed)) {
           break;
         }
+        contention_cas_failure();
+        backoff_cas_failure();
         bool _ = find(set, key, preds, succs);
       }
     }
@@ -220,6 +248,8 @@ int c_fhsl_lf_remove_leaky(c_fhsl_lf_t * set, int64_t key) {
       } else if(marked) {
         return false;
       }
+      contention_cas_failure();
+      backoff_cas_failure();
     }
   }
 }
@@ -252,11 +282,14 @@ int c_fhsl_lf_remove(c_fhsl_lf_t * set, int64_t key) {
       marked = node_is_marked(succ);
       if(i_marked_it) {
         bool _ = find(set, key, preds, succs);
+        alloc_stats_retire((void*)node_to_remove);
         forkscan_retire(node_to_remove);
         return true;
       } else if(marked) {
         return false;
       }
+      contention_cas_failure();
+      backoff_cas_failure();
     }
   }
 }
@@ -323,8 +356,26 @@ int c_fhsl_lf_pop_min(c_fhsl_lf_t *set) {
 
         if (atomic_compare_exchange_weak_explicit(&node_to_remove->next[BOTTOM], &succ, node_mark(succ), memory_order_relaxed, memory_order_relaxed)) {
             bool _ = find(set, node_to_remove->key, preds, succs);
+            alloc_stats_retire((void*)node_to_remove);
             forkscan_retire(node_to_remove);
             return true;
         }
     }
-}
\ No newline at end of file
+}
+
+// micro_bench hooks only; not part of the set API.
+uint64_t c_fhsl_lf_micro_fast_rand(uint64_t *seed, int64_t n) {
+  uint64_t sum = 0;
+  for(int64_t i = 0; i < n; i++) {
+    sum ^= fast_rand(seed);
+  }
+  return sum;
+}
+
+uint64_t c_fhsl_lf_micro_random_level(uint64_t *seed, int64_t n) {
+  uint64_t sum = 0;
+  for(int64_t i = 0; i < n; i++) {
+    sum += random_level(seed, N);
+  }
+  return sum;
+}
@@ -12,4 +12,8 @@ int c_fhsl_lf_remove_leaky(c_fhsl_lf_t * set, int64_t key);
 int c_fhsl_lf_remove(c_fhsl_lf_t * set, int64_t key);
 int c_fhsl_lf_pop_min_leaky(c_fhsl_lf_t *set);
 int c_fhsl_lf_pop_min(c_fhsl_lf_t *set);
-void c_fhsl_lf_print (c_fhsl_lf_t *set);
\ No newline at end of file
+void c_fhsl_lf_print (c_fhsl_lf_t *set);
+
+// micro_bench hooks only; not part of the set API.
+uint64_t c_fhsl_lf_micro_fast_rand(uint64_t *seed, int64_t n);
+uint64_t c_fhsl_lf_micro_random_level(uint64_t *seed, int64_t n);
@@ -3,6 +3,8 @@
  */
 
 #include "c_lj_pq.h"
+#include "contention_hooks.h"
+#include "backoff.h"
 
 #include <stdbool.h>
 #include <forkscan.h>
@@ -105,6 +107,7 @@ static node_ptr locate_preds(
   node_ptr cur = &set->head, next = NULL, del = NULL;
   int32_t level = N - 1;
   bool deleted = false;
+  int64_t traversed = 0;
   while(level >= 0) {
     next = cur->next[level];
     deleted = is_marked(next);
@@ -120,11 +123,13 @@ static node_ptr locate_preds(
       next = next->next[level];
       deleted = is_marked(next);
       next = unmark(next);
+      traversed++;
     }
     preds[level] = cur;
     succs[level] = next;
     level--;
   }
+  contention_traversed(traversed);
   return del;
 }
 
@@ -148,7 +153,11 @@ int c_lj_pq_add(uint64_t *seed, c_lj_pq_t * set, int64_t key) {
     if(node == NULL) { node = node_create(key, toplevel); }
     for(int64_t i = 0; i <= toplevel; ++i) { node->next[i] = succs[i]; }
     node_ptr pred = preds[0], succ = succs[0];
-    if(!__sync_bool_compare_and_swap(&pred->next[0], succ, node)) { continue; }
+    if(!__sync_bool_compare_and_swap(&pred->next[0], succ, node)) {
+      contention_cas_failure();
+      backoff_cas_failure();
+      continue;
+    }
 
     for(int64_t i = 1; i <= toplevel; i++) {
 
@@ -162,6 +171,7 @@ int c_lj_pq_add(uint64_t *seed, c_lj_pq_t * set, int64_t key) {
       node->next[i] = succs[i];
 
       if(!__sync_bool_compare_and_swap(&preds[i]->next[i], succs[i], node)) {
+        contention_cas_failure();
         del = locate_preds(set, key, preds, succs);
         if(succs[0] != node) {
           node->insert_state = INSERTED;
@@ -192,15 +202,17 @@ static void restructure(c_lj_pq_t *set) {
     }
     if(__sync_bool_compare_and_swap(&set->head.next[level], head, cur)){
       level--;
+    } else {
+      backoff_cas_failure();
     }
   }
 }
 
 
-/** Pop the front node from the list.  Return true iff there was a node to pop.
- *  Leak the memory.
+/** Pop the front node from the list.  Return true iff there was a node to pop,
+ *  and store its key in priority.  Leak the memory.
  */
-int c_lj_pq_leaky_pop_min(c_lj_pq_t * set) {
+int c_lj_pq_leaky_pop_min(c_lj_pq_t * set, int64_t *priority) {
   node_ptr cur = &set->head, next = NULL, newhead = NULL,
     obs_head = NULL;
   int32_t offset = 0;
@@ -208,19 +220,27 @@ int c_lj_pq_leaky_pop_min(c_lj_pq_t * set) {
   do {
     offset++;
     next = cur->next[0];
-    if(unmark(next) == &set->tail) { return false; }
+    if(unmark(next) == &set->tail) {
+      contention_traversed(offset);
+      return false;
+    }
     if(newhead == NULL && cur->insert_state == INSERT_PENDING) { newhead = cur; }
     if(is_marked(next)) { continue; }
     next = (node_ptr)__sync_fetch_and_or((uintptr_t*)&cur->next[0], (uintptr_t)1);
   } while((cur = unmark(next)) && is_marked(next));
-  
 
+  // cur is the node whose deletion mark we set.
+  *priority = cur->key;
   if(newhead == NULL) { newhead = cur; }
+  contention_traversed(offset);
   if(offset <= set->boundoffset) { return true; }
   if(set->head.next[0] != obs_head) { return true; }
 
   if(__sync_bool_compare_and_swap(&set->head.next[0], obs_head, mark(newhead))) {
+    contention_snipped(offset);
     restructure(set);
+  } else {
+    contention_cas_failure();
   }
   return true;
 }
\ No newline at end of file
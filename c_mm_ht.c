@@ -1,4 +1,6 @@
 #include "c_mm_ht.h"
+#include "contention_hooks.h"
+#include "backoff.h"
 #include <forkscan.h>
 #include <stdbool.h>
 
@@ -39,26 +41,37 @@ static bool is_marked(node_ptr ptr) {
 }
 
 static bool find(list_view_t * view, node_ptr *head, key_t key) {
+  int64_t traversed = 0;
 try_again:
   view->previous = head;
   view->current = *head;
   while(true) {
-    if(unmark(view->current) == NULL) return false;
+    if(unmark(view->current) == NULL) {
+      contention_traversed(traversed);
+      return false;
+    }
+    traversed++;
     view->next = unmark(view->current)->next;
     key_t cur_key = unmark(view->current)->key;
     if(*view->previous != unmark(view->current)) {
+      contention_restart();
       goto try_again;
     }
     if(!is_marked(view->next)) {
       if(cur_key >= key) {
+        contention_traversed(traversed);
         return cur_key == key;
       }
       view->previous = &unmark(view->current)->next;
     } else {
       // Shortened down since it's leaky memory.
       if(!__sync_bool_compare_and_swap(view->previous, unmark(view->current), unmark(view->next))) {
+        contention_cas_failure();
+        backoff_cas_failure();
+        contention_restart();
         goto try_again;
       }
+      contention_snipped(1);
     }
     view->current = view->next;
   }
@@ -99,6 +112,8 @@ int c_mm_ht_add(c_mm_ht_t * set, key_t key) {
     if(__sync_bool_compare_and_swap(view.previous, unmark(view.current), new_node)) {
       return true;
     }
+    contention_cas_failure();
+    backoff_cas_failure();
   }
 }
 
@@ -111,6 +126,8 @@ int c_mm_ht_remove_leaky(c_mm_ht_t * set, key_t key) {
       return false;
     }
     if(!__sync_bool_compare_and_swap(&view.current->next, unmark(view.next), mark(view.next))) {
+      contention_cas_failure();
+      backoff_cas_failure();
       continue;
     }
     if(!__sync_bool_compare_and_swap(view.previous, unmark(view.current), unmark(view.next))) {
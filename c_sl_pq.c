@@ -5,6 +5,9 @@
  */
 
 #include "c_sl_pq.h"
+#include "alloc_stats.h"
+#include "contention_hooks.h"
+#include "backoff.h"
 
 #include <stdbool.h>
 #include <stdatomic.h>
@@ -126,6 +129,7 @@ static void mark_pointers(node_ptr node) {
 static bool find(c_sl_pq_t *pqueue, int64_t key, 
   node_ptr preds[N], node_ptr succs[N]) {
   bool marked, snip;
+  int64_t traversed = 0;
   // node_ptr pred = NULL, curr = NULL, succ = NULL;
 retry:
   while(true) {
@@ -133,8 +137,12 @@ retry:
     for(int64_t level = N - 1; level >= BOTTOM; --level) {
       node_ptr left_next = atomic_load_explicit(&left->next[level], memory_order_consume);
       // Is our current node invalid?
-      if(node_is_marked(left_next)) { goto retry; }
+      if(node_is_marked(left_next)) {
+        contention_restart();
+        goto retry;
+      }
       node_ptr right = left_next;
+      int64_t skipped = 0;
       // Find two nodes to put into preds and succs.
       while(true) {
         // Scan to the right so long as we find deleted nodes.
@@ -142,26 +150,38 @@ retry:
         while(node_is_marked(right_next)) {
           right = node_unmark(right_next);
           right_next = atomic_load_explicit(&right->next[level], memory_order_consume);
+          skipped++;
         }
+        traversed++;
         // Has the right not gone far enough?        
         if(right->key < key) {
           left = right;
           left_next = right_next;
           right = right_next;
+          traversed += skipped;
+          skipped = 0;
         } else {
           // Right node is greater than our key, he's our succ, break.
           break;
         }
       }
+      traversed += skipped;
       // Ensure the left node points to the right node, they must be adjacent.
       if(left_next != right) {
         bool success = atomic_compare_exchange_weak_explicit(&left->next[level], &left_next, right,
           memory_order_release, memory_order_relaxed);
-        if(!success) { goto retry; }
+        if(!success) {
+          contention_cas_failure();
+          backoff_cas_failure();
+          contention_restart();
+          goto retry;
+        }
+        contention_snipped(skipped);
       }
       preds[level] = left;
       succs[level] = right;
     }
+    contention_traversed(traversed);
     return succs[BOTTOM]->key == key;
   }
 }
@@ -267,6 +287,7 @@ int c_sl_pq_remove(c_sl_pq_t * pqueue, int64_t key) {
       marked = node_is_marked(succ);
       if(i_marked_it) {
         bool _ = find(pqueue, key, preds, succs);
+        alloc_stats_retire((void*)node_to_remove);
         forkscan_retire(node_to_remove);
         return true;
       } else if(marked) {
@@ -278,7 +299,7 @@ int c_sl_pq_remove(c_sl_pq_t * pqueue, int64_t key) {
 
 /** Remove the minimum element in the Shavit Lotan priority queue.
  */
-int c_sl_pq_leaky_pop_min(c_sl_pq_t * pqueue) {
+int c_sl_pq_leaky_pop_min(c_sl_pq_t * pqueue, int64_t *priority) {
   node_ptr left_next = node_unmark(atomic_load_explicit(&pqueue->head.next[BOTTOM], memory_order_consume));
   if(left_next == &pqueue->tail) { return false; }
   node_ptr curr = left_next;
@@ -288,6 +309,7 @@ int c_sl_pq_leaky_pop_min(c_sl_pq_t * pqueue) {
       continue;
     }
     if(!atomic_exchange_explicit(&curr->deleted, true, memory_order_relaxed)){
+      *priority = curr->key;
       mark_pointers(curr);
       return true;
     }
@@ -297,7 +319,7 @@ int c_sl_pq_leaky_pop_min(c_sl_pq_t * pqueue) {
 
 /** Remove the minimum element in the Shavit Lotan priority queue.
  */
-int c_sl_pq_pop_min(c_sl_pq_t * pqueue) {
+int c_sl_pq_pop_min(c_sl_pq_t * pqueue, int64_t *priority) {
   while(true) {
     node_ptr curr = node_unmark(atomic_load_explicit(&pqueue->head.next[0], memory_order_consume));
     if(curr == &pqueue->tail) {
@@ -308,6 +330,7 @@ int c_sl_pq_pop_min(c_sl_pq_t * pqueue) {
         continue;
       }
       if(!atomic_exchange_explicit(&curr->deleted, true, memory_order_relaxed)){
+        *priority = curr->key;
         bool res = c_sl_pq_remove(pqueue, curr->key);
         return true;
       }
@@ -1,4 +1,6 @@
 #include "c_so_ht.h"
+#include "contention_hooks.h"
+#include "backoff.h"
 #include <forkscan.h>
 #include <stdbool.h>
 #include <stdio.h>
@@ -80,26 +82,37 @@ void c_so_ht_print(c_so_ht_t *set) {
 }
 
 static bool find(list_view_t * view, node_ptr *head, uint64_t key) {
+  int64_t traversed = 0;
 try_again:
   view->previous = head;
   view->current = *head;
   while(true) {
-    if(unmark(view->current) == NULL) return false;
+    if(unmark(view->current) == NULL) {
+      contention_traversed(traversed);
+      return false;
+    }
+    traversed++;
     view->next = unmark(view->current)->next;
     uint64_t cur_key = unmark(view->current)->key;
     if(*view->previous != unmark(view->current)) {
+      contention_restart();
       goto try_again;
     }
     if(!is_marked(view->current)) {
       if(cur_key >= key) {
+        contention_traversed(traversed);
         return cur_key == key;
       }
       view->previous = &unmark(view->current)->next;
     } else {
       // Shortened down since it's leaky memory.
       if(!__sync_bool_compare_and_swap(view->previous, view->current, view->next)) {
+        contention_cas_failure();
+        backoff_cas_failure();
+        contention_restart();
         goto try_again;
       }
+      contention_snipped(1);
     }
     view->current = view->next;
   }
@@ -116,6 +129,8 @@ static int c_list_add(list_view_t *view, node_ptr *head, node_ptr new_node) {
     if(__sync_bool_compare_and_swap(view->previous, view->current, new_node)) {
       return true;
     }
+    contention_cas_failure();
+    backoff_cas_failure();
   }
 }
 
@@ -126,6 +141,8 @@ static int c_list_remove_leaky(node_ptr *head, uint64_t key) {
       return false;
     }
     if(!__sync_bool_compare_and_swap(&view.current->next, view.next, mark(view.next))) {
+      contention_cas_failure();
+      backoff_cas_failure();
       continue;
     }
     // unmark(view.next) -> the bane of my life
@@ -215,3 +232,20 @@ int c_so_ht_remove_leaky(c_so_ht_t *set, key_t key) {
   size_t _ = __sync_fetch_and_sub(&set->count, 1);
   return true;
 }
+
+// micro_bench hooks only; not part of the set API.
+uint64_t c_so_ht_micro_reverse_bits(const uint64_t *keys, int64_t n) {
+  uint64_t sum = 0;
+  for(int64_t i = 0; i < n; i++) {
+    sum ^= reverse_bits(keys[i]);
+  }
+  return sum;
+}
+
+uint64_t c_so_ht_micro_get_parent(const uint64_t *keys, int64_t n) {
+  uint64_t sum = 0;
+  for(int64_t i = 0; i < n; i++) {
+    sum ^= get_parent(keys[i]);
+  }
+  return sum;
+}
@@ -13,4 +13,8 @@ c_so_ht_t * c_so_ht_create(uint64_t size, uint64_t max_load);
 int c_so_ht_contains(c_so_ht_t *set, int64_t key);
 int c_so_ht_add(c_so_ht_t *set, int64_t key);
 int c_so_ht_remove_leaky(c_so_ht_t *set, int64_t key);
-void c_so_ht_print(c_so_ht_t *set);
\ No newline at end of file
+void c_so_ht_print(c_so_ht_t *set);
+
+// micro_bench hooks only; not part of the set API.
+uint64_t c_so_ht_micro_reverse_bits(const uint64_t *keys, int64_t n);
+uint64_t c_so_ht_micro_get_parent(const uint64_t *keys, int64_t n);
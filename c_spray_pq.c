@@ -5,6 +5,9 @@
  */
 
 #include "c_spray_pq.h"
+#include "alloc_stats.h"
+#include "contention_hooks.h"
+#include "backoff.h"
 
 #include <stdbool.h>
 #include <stdatomic.h>
@@ -185,6 +188,7 @@ static void mark_pointers(node_ptr node) {
 static bool find(c_spray_pq_t *pqueue, int64_t key, 
   node_ptr preds[N], node_ptr succs[N]) {
   bool marked, snip;
+  int64_t traversed = 0;
   // node_ptr pred = NULL, curr = NULL, succ = NULL;
 retry:
   while(true) {
@@ -192,8 +196,12 @@ retry:
     for(int64_t level = N - 1; level >= BOTTOM; --level) {
       node_ptr left_next = atomic_load_explicit(&left->next[level], memory_order_consume);
       // Is our current node invalid?
-      if(node_is_marked(left_next)) { goto retry; }
+      if(node_is_marked(left_next)) {
+        contention_restart();
+        goto retry;
+      }
       node_ptr right = left_next;
+      int64_t skipped = 0;
       // Find two nodes to put into preds and succs.
       while(true) {
         // Scan to the right so long as we find deleted nodes.
@@ -201,26 +209,38 @@ retry:
         while(node_is_marked(right_next)) {
           right = node_unmark(right_next);
           right_next = atomic_load_explicit(&right->next[level], memory_order_consume);
+          skipped++;
         }
+        traversed++;
         // Has the right not gone far enough?        
         if(right->key < key) {
           left = right;
           left_next = right_next;
           right = right_next;
+          traversed += skipped;
+          skipped = 0;
         } else {
           // Right node is greater than our key, he's our succ, break.
           break;
         }
       }
+      traversed += skipped;
       // Ensure the left node points to the right node, they must be adjacent.
       if(left_next != right) {
         bool success = atomic_compare_exchange_weak_explicit(&left->next[level], &left_next, right,
           memory_order_release, memory_order_relaxed);
-        if(!success) { goto retry; }
+        if(!success) {
+          contention_cas_failure();
+          backoff_cas_failure();
+          contention_restart();
+          goto retry;
+        }
+        contention_snipped(skipped);
       }
       preds[level] = left;
       succs[level] = right;
     }
+    contention_traversed(traversed);
     return succs[BOTTOM]->key == key;
   }
 }
@@ -282,7 +302,8 @@ static node_ptr spray(uint64_t * seed, c_spray_pq_t * pqueue) {
 
 /** Pop the front node from the list.  Return true iff there was a node to pop.
  */
-int c_spray_pq_leaky_pop_min(uint64_t *seed, c_spray_pq_t *pqueue) {
+int c_spray_pq_leaky_pop_min(uint64_t *seed, c_spray_pq_t *pqueue,
+                             int64_t *priority) {
 
   bool cleaner = ((fast_rand(seed) % (pqueue->config.thread_count)) == 0);
   if(cleaner) {
@@ -297,6 +318,7 @@ int c_spray_pq_leaky_pop_min(uint64_t *seed, c_spray_pq_t *pqueue) {
       if(state == ACTIVE) {
         if(!claimed_node) {
           claimed_node = (atomic_exchange_explicit(&right->state, DELETED, memory_order_relaxed) == ACTIVE);
+          if(claimed_node) { *priority = right->key; }
           mark_pointers(right);
           continue;
         }
@@ -321,6 +343,7 @@ int c_spray_pq_leaky_pop_min(uint64_t *seed, c_spray_pq_t *pqueue) {
       if(state == DELETED) { continue; }
       if(state == ACTIVE && 
         (atomic_exchange_explicit(&node->state, DELETED, memory_order_relaxed) == ACTIVE)) {
+        *priority = node->key;
         mark_pointers(node);
         return true;
       }
@@ -330,7 +353,7 @@ int c_spray_pq_leaky_pop_min(uint64_t *seed, c_spray_pq_t *pqueue) {
 }
 
 
-int c_spray_pq_pop_min(uint64_t *seed, c_spray_pq_t *pqueue) {
+int c_spray_pq_pop_min(uint64_t *seed, c_spray_pq_t *pqueue, int64_t *priority) {
     bool cleaner = ((fast_rand(seed) % (pqueue->config.thread_count)) == 0);
   if(cleaner) {
     node_ptr left = &pqueue->head;
@@ -344,7 +367,11 @@ int c_spray_pq_pop_min(uint64_t *seed, c_spray_pq_t *pqueue) {
       if(state == ACTIVE) {
         if(!claimed_node) {
           claimed_node = (atomic_exchange_explicit(&right->state, DELETED, memory_order_relaxed) == ACTIVE);
-          if(claimed_node) { forkscan_retire(right); }
+          if(claimed_node) {
+            *priority = right->key;
+            alloc_stats_retire((void*)right);
+            forkscan_retire(right);
+          }
           mark_pointers(right);
           continue;
         }
@@ -379,6 +406,8 @@ int c_spray_pq_pop_min(uint64_t *seed, c_spray_pq_t *pqueue) {
       if(state == DELETED) { continue; }
       if(state == ACTIVE && 
         (atomic_exchange_explicit(&node->state, DELETED, memory_order_relaxed) == ACTIVE)) {
+        *priority = node->key;
+        alloc_stats_retire((void*)node);
         forkscan_retire(node);
         mark_pointers(node);
         return true;
@@ -0,0 +1,23 @@
+/* The contention hooks as the C structures see them.  Without
+ * CONTENTION_STATS they are empty inline functions, so the default build
+ * pays nothing for them; with it they are the counters in
+ * contention_stats.c.  The DEF structures import contention_stats.h and
+ * get the same folding from the Makefile.
+ */
+
+#pragma once
+
+#ifdef CONTENTION_STATS
+
+#include "contention_stats.h"
+
+#else
+
+#include <stdint.h>
+
+static inline void contention_cas_failure() {}
+static inline void contention_restart() {}
+static inline void contention_traversed(int64_t nodes) {}
+static inline void contention_snipped(int64_t nodes) {}
+
+#endif
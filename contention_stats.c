@@ -0,0 +1,32 @@
+#include "contention_stats.h"
+
+#ifdef CONTENTION_STATS
+
+static __thread int64_t cas_failures = 0, restarts = 0, traversed = 0,
+  snipped = 0;
+
+int contention_enabled() { return 1; }
+void contention_cas_failure() { cas_failures++; }
+void contention_restart() { restarts++; }
+void contention_traversed(int64_t nodes) { traversed += nodes; }
+void contention_snipped(int64_t nodes) { snipped += nodes; }
+
+int64_t contention_thread_cas_failures() { return cas_failures; }
+int64_t contention_thread_restarts() { return restarts; }
+int64_t contention_thread_traversed() { return traversed; }
+int64_t contention_thread_snipped() { return snipped; }
+
+#else
+
+int contention_enabled() { return 0; }
+void contention_cas_failure() {}
+void contention_restart() {}
+void contention_traversed(int64_t nodes) {}
+void contention_snipped(int64_t nodes) {}
+
+int64_t contention_thread_cas_failures() { return 0; }
+int64_t contention_thread_restarts() { return 0; }
+int64_t contention_thread_traversed() { return 0; }
+int64_t contention_thread_snipped() { return 0; }
+
+#endif
@@ -0,0 +1,20 @@
+/* Per-thread contention and traversal counters for the data structures.
+ * The counting is compiled in only when CONTENTION_STATS is defined (build
+ * with `make CONTENTION=1`); otherwise the hooks are empty, their calls
+ * fold away (see contention_hooks.h) and contention_enabled() returns 0.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+int contention_enabled();
+void contention_cas_failure();
+void contention_restart();
+void contention_traversed(int64_t nodes);
+void contention_snipped(int64_t nodes);
+
+int64_t contention_thread_cas_failures();
+int64_t contention_thread_restarts();
+int64_t contention_thread_traversed();
+int64_t contention_thread_snipped();
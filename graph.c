@@ -0,0 +1,229 @@
+#include "graph.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+// Graph500 R-MAT quadrant probabilities; the fourth is 1 - a - b - c.
+#define RMAT_A 0.57
+#define RMAT_B 0.19
+#define RMAT_C 0.19
+
+typedef struct edge_t edge_t;
+typedef struct heap_entry_t heap_entry_t;
+
+struct edge_t {
+  int32_t source, target, weight;
+};
+
+struct heap_entry_t {
+  int64_t distance;
+  int32_t vertex;
+};
+
+struct graph_t {
+  int64_t vertices, edges;
+  int32_t vertex_bits;
+  int64_t *offsets;
+  int32_t *targets, *weights;
+};
+
+static uint64_t fast_rand(uint64_t *seed) {
+  uint64_t val = *seed;
+  if(val == 0) {
+    val = 1;
+  }
+  val ^= val << 6;
+  val ^= val >> 21;
+  val ^= val << 7;
+  *seed = val;
+  return val;
+}
+
+static double uniform(uint64_t *seed) {
+  return (fast_rand(seed) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static int32_t random_weight(uint64_t *seed, int32_t max_weight) {
+  return 1 + (int32_t)(fast_rand(seed) % max_weight);
+}
+
+/** Build the compressed rows from an undirected edge list, adding each edge
+ *  in both directions.
+ */
+static graph_t * graph_build(int64_t vertices, edge_t *list, int64_t count) {
+  graph_t *graph = malloc(sizeof(graph_t));
+  graph->vertices = vertices;
+  graph->edges = 2 * count;
+  graph->vertex_bits = 1;
+  while(((int64_t)1 << graph->vertex_bits) < vertices) {
+    graph->vertex_bits++;
+  }
+  graph->offsets = calloc(vertices + 1, sizeof(int64_t));
+  graph->targets = malloc(sizeof(int32_t) * graph->edges);
+  graph->weights = malloc(sizeof(int32_t) * graph->edges);
+
+  for(int64_t i = 0; i < count; i++) {
+    graph->offsets[list[i].source + 1]++;
+    graph->offsets[list[i].target + 1]++;
+  }
+  for(int64_t v = 0; v < vertices; v++) {
+    graph->offsets[v + 1] += graph->offsets[v];
+  }
+  int64_t *next = malloc(sizeof(int64_t) * vertices);
+  for(int64_t v = 0; v < vertices; v++) {
+    next[v] = graph->offsets[v];
+  }
+  for(int64_t i = 0; i < count; i++) {
+    int64_t forward = next[list[i].source]++;
+    graph->targets[forward] = list[i].target;
+    graph->weights[forward] = list[i].weight;
+    int64_t backward = next[list[i].target]++;
+    graph->targets[backward] = list[i].source;
+    graph->weights[backward] = list[i].weight;
+  }
+  free(next);
+  return graph;
+}
+
+/** Generate an R-MAT graph of 2^scale vertices and edge_factor * 2^scale
+ *  undirected edges, without self loops.  Vertex 0 is the densest corner.
+ */
+graph_t * graph_rmat(int32_t scale, int32_t edge_factor, int32_t max_weight,
+                     uint64_t seed) {
+  int64_t vertices = (int64_t)1 << scale;
+  int64_t count = vertices * edge_factor;
+  edge_t *list = malloc(sizeof(edge_t) * count);
+  for(int64_t i = 0; i < count; i++) {
+    int32_t source, target;
+    do {
+      source = target = 0;
+      for(int32_t bit = scale - 1; bit >= 0; bit--) {
+        double r = uniform(&seed);
+        if(r < RMAT_A) {
+          // Top-left quadrant.
+        } else if(r < RMAT_A + RMAT_B) {
+          target |= 1 << bit;
+        } else if(r < RMAT_A + RMAT_B + RMAT_C) {
+          source |= 1 << bit;
+        } else {
+          source |= 1 << bit;
+          target |= 1 << bit;
+        }
+      }
+    } while(source == target);
+    list[i] = (edge_t){ source, target, random_weight(&seed, max_weight) };
+  }
+  graph_t *graph = graph_build(vertices, list, count);
+  free(list);
+  return graph;
+}
+
+/** Generate a side x side grid with edges between 4-neighbours.
+ */
+graph_t * graph_grid(int32_t side, int32_t max_weight, uint64_t seed) {
+  int64_t vertices = (int64_t)side * side;
+  int64_t count = 2 * (int64_t)side * (side - 1);
+  edge_t *list = malloc(sizeof(edge_t) * count);
+  int64_t i = 0;
+  for(int32_t row = 0; row < side; row++) {
+    for(int32_t col = 0; col < side; col++) {
+      int32_t v = row * side + col;
+      if(col + 1 < side) {
+        list[i++] = (edge_t){ v, v + 1, random_weight(&seed, max_weight) };
+      }
+      if(row + 1 < side) {
+        list[i++] = (edge_t){ v, v + side, random_weight(&seed, max_weight) };
+      }
+    }
+  }
+  graph_t *graph = graph_build(vertices, list, count);
+  free(list);
+  return graph;
+}
+
+void graph_destroy(graph_t *graph) {
+  free(graph->offsets);
+  free(graph->targets);
+  free(graph->weights);
+  free(graph);
+}
+
+int64_t graph_vertices(graph_t *graph) {
+  return graph->vertices;
+}
+
+int64_t graph_edges(graph_t *graph) {
+  return graph->edges;
+}
+
+/** Return the bits needed to hold a vertex id.
+ */
+int32_t graph_vertex_bits(graph_t *graph) {
+  return graph->vertex_bits;
+}
+
+int64_t * graph_offsets(graph_t *graph) {
+  return graph->offsets;
+}
+
+int32_t * graph_targets(graph_t *graph) {
+  return graph->targets;
+}
+
+int32_t * graph_weights(graph_t *graph) {
+  return graph->weights;
+}
+
+static void heap_push(heap_entry_t *heap, int64_t *size, heap_entry_t entry) {
+  int64_t i = (*size)++;
+  while(i > 0 && heap[(i - 1) / 2].distance > entry.distance) {
+    heap[i] = heap[(i - 1) / 2];
+    i = (i - 1) / 2;
+  }
+  heap[i] = entry;
+}
+
+static heap_entry_t heap_pop(heap_entry_t *heap, int64_t *size) {
+  heap_entry_t top = heap[0], last = heap[--(*size)];
+  int64_t i = 0;
+  while(2 * i + 1 < *size) {
+    int64_t child = 2 * i + 1;
+    if(child + 1 < *size && heap[child + 1].distance < heap[child].distance) {
+      child++;
+    }
+    if(heap[child].distance >= last.distance) { break; }
+    heap[i] = heap[child];
+    i = child;
+  }
+  heap[i] = last;
+  return top;
+}
+
+/** Return the shortest distance from source to every vertex, INT64_MAX for
+ *  the unreachable ones.  The caller frees the array.
+ */
+int64_t * graph_dijkstra(graph_t *graph, int32_t source) {
+  int64_t *distance = malloc(sizeof(int64_t) * graph->vertices);
+  for(int64_t v = 0; v < graph->vertices; v++) {
+    distance[v] = INT64_MAX;
+  }
+  // Lazy deletion: a vertex is pushed at most once per in-edge.
+  heap_entry_t *heap = malloc(sizeof(heap_entry_t) * (graph->edges + 1));
+  int64_t size = 0;
+  distance[source] = 0;
+  heap_push(heap, &size, (heap_entry_t){ 0, source });
+  while(size > 0) {
+    heap_entry_t top = heap_pop(heap, &size);
+    if(top.distance > distance[top.vertex]) { continue; }
+    for(int64_t e = graph->offsets[top.vertex];
+        e < graph->offsets[top.vertex + 1]; e++) {
+      int64_t candidate = top.distance + graph->weights[e];
+      int32_t target = graph->targets[e];
+      if(candidate < distance[target]) {
+        distance[target] = candidate;
+        heap_push(heap, &size, (heap_entry_t){ candidate, target });
+      }
+    }
+  }
+  free(heap);
+  return distance;
+}
@@ -0,0 +1,24 @@
+/* Synthetic weighted graphs for the shortest-path benchmark.
+ * Graphs are stored as compressed sparse rows: the out-edges of vertex v
+ * are targets[offsets[v]] .. targets[offsets[v + 1] - 1], with matching
+ * weights.  Every edge is added in both directions.  A sequential binary
+ * heap Dijkstra gives the reference distances and baseline time.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+typedef struct graph_t graph_t;
+
+graph_t * graph_rmat(int32_t scale, int32_t edge_factor, int32_t max_weight,
+                     uint64_t seed);
+graph_t * graph_grid(int32_t side, int32_t max_weight, uint64_t seed);
+void graph_destroy(graph_t *graph);
+int64_t graph_vertices(graph_t *graph);
+int64_t graph_edges(graph_t *graph);
+int32_t graph_vertex_bits(graph_t *graph);
+int64_t * graph_offsets(graph_t *graph);
+int32_t * graph_targets(graph_t *graph);
+int32_t * graph_weights(graph_t *graph);
+int64_t * graph_dijkstra(graph_t *graph, int32_t source);
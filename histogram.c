@@ -0,0 +1,100 @@
+#include "histogram.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Values below SUB_BUCKETS are recorded exactly.  Above that each power of two
+// is split into SUB_BUCKETS / 2 linear buckets, which bounds the relative
+// error of any reported value to roughly 6%.
+#define SUB_BUCKET_BITS 5
+#define SUB_BUCKETS (1 << SUB_BUCKET_BITS)
+#define HALF_SUB_BUCKETS (SUB_BUCKETS / 2)
+#define BUCKETS ((64 - SUB_BUCKET_BITS + 1) * HALF_SUB_BUCKETS + HALF_SUB_BUCKETS)
+
+struct histogram_t {
+  uint64_t count, max;
+  uint64_t buckets[BUCKETS];
+};
+
+static uint32_t bucket_index(uint64_t value) {
+  if(value < SUB_BUCKETS) { return value; }
+  uint32_t shift = (63 - __builtin_clzll(value)) - (SUB_BUCKET_BITS - 1);
+  return shift * HALF_SUB_BUCKETS + (uint32_t)(value >> shift);
+}
+
+// Highest value that maps to the bucket at index.
+static uint64_t bucket_value(uint32_t index) {
+  if(index < SUB_BUCKETS) { return index; }
+  uint32_t shift = index / HALF_SUB_BUCKETS - 1;
+  uint64_t sub_bucket = index - shift * HALF_SUB_BUCKETS;
+  return ((sub_bucket + 1) << shift) - 1;
+}
+
+histogram_t * histogram_create() {
+  histogram_t *hist = malloc(sizeof(histogram_t));
+  memset(hist, 0, sizeof(histogram_t));
+  return hist;
+}
+
+void histogram_destroy(histogram_t *hist) {
+  free(hist);
+}
+
+void histogram_record(histogram_t *hist, uint64_t value) {
+  hist->buckets[bucket_index(value)]++;
+  hist->count++;
+  if(value > hist->max) { hist->max = value; }
+}
+
+void histogram_merge(histogram_t *into, histogram_t *from) {
+  for(uint32_t i = 0; i < BUCKETS; i++) {
+    into->buckets[i] += from->buckets[i];
+  }
+  into->count += from->count;
+  if(from->max > into->max) { into->max = from->max; }
+}
+
+void histogram_reset(histogram_t *hist) {
+  memset(hist, 0, sizeof(histogram_t));
+}
+
+/** Remove the values of base, an earlier snapshot of the same histogram,
+ *  from into.  Only the bucket of the largest remaining value is known, so
+ *  the max becomes that bucket's upper bound, or the old max if smaller.
+ */
+void histogram_subtract(histogram_t *into, histogram_t *base) {
+  uint32_t highest = 0;
+  for(uint32_t i = 0; i < BUCKETS; i++) {
+    into->buckets[i] -= base->buckets[i];
+    if(into->buckets[i] != 0) { highest = i; }
+  }
+  into->count -= base->count;
+  if(into->count == 0) {
+    into->max = 0;
+  } else if(bucket_value(highest) < into->max) {
+    into->max = bucket_value(highest);
+  }
+}
+
+uint64_t histogram_count(histogram_t *hist) {
+  return hist->count;
+}
+
+uint64_t histogram_max(histogram_t *hist) {
+  return hist->max;
+}
+
+uint64_t histogram_percentile(histogram_t *hist, double percentile) {
+  if(hist->count == 0) { return 0; }
+  uint64_t target = (uint64_t)((percentile / 100.0) * hist->count + 0.5);
+  if(target == 0) { target = 1; }
+  if(target > hist->count) { target = hist->count; }
+  uint64_t seen = 0;
+  for(uint32_t i = 0; i < BUCKETS; i++) {
+    seen += hist->buckets[i];
+    if(seen >= target) {
+      uint64_t value = bucket_value(i);
+      return value < hist->max ? value : hist->max;
+    }
+  }
+  return hist->max;
+}
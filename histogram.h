@@ -0,0 +1,20 @@
+/* Log-linear ("HDR-style") latency histogram.
+ * Each histogram has a single writer, so recording is a plain increment with
+ * no atomics.  Per-thread histograms are merged after the threads are joined.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+typedef struct histogram_t histogram_t;
+
+histogram_t * histogram_create();
+void histogram_destroy(histogram_t *hist);
+void histogram_record(histogram_t *hist, uint64_t value);
+void histogram_merge(histogram_t *into, histogram_t *from);
+void histogram_reset(histogram_t *hist);
+void histogram_subtract(histogram_t *into, histogram_t *base);
+uint64_t histogram_count(histogram_t *hist);
+uint64_t histogram_max(histogram_t *hist);
+uint64_t histogram_percentile(histogram_t *hist, double percentile);
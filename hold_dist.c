@@ -0,0 +1,81 @@
+#include "hold_dist.h"
+#include <math.h>
+#include <stdlib.h>
+
+// The bimodal distribution draws BIMODAL_SMALL_SHARE of its increments
+// from a narrow mode near zero and the rest from a wide mode, weighted so
+// the mean is unchanged.
+#define BIMODAL_SMALL_SHARE 0.9
+#define BIMODAL_SMALL_MEAN 0.1
+
+typedef enum { HOLD_EXPONENTIAL, HOLD_UNIFORM, HOLD_BIMODAL } kind_t;
+
+struct hold_dist_t {
+  kind_t kind;
+  double mean;
+};
+
+static uint64_t fast_rand(uint64_t *seed) {
+  uint64_t val = *seed;
+  if(val == 0) {
+    val = 1;
+  }
+  val ^= val << 6;
+  val ^= val >> 21;
+  val ^= val << 7;
+  *seed = val;
+  return val;
+}
+
+static double uniform(uint64_t *seed) {
+  return (fast_rand(seed) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static hold_dist_t * hold_dist_create(kind_t kind, double mean) {
+  hold_dist_t *dist = malloc(sizeof(hold_dist_t));
+  dist->kind = kind;
+  dist->mean = mean;
+  return dist;
+}
+
+hold_dist_t * hold_dist_exponential(double mean) {
+  return hold_dist_create(HOLD_EXPONENTIAL, mean);
+}
+
+/** Increments uniform on [0, 2 * mean).
+ */
+hold_dist_t * hold_dist_uniform(double mean) {
+  return hold_dist_create(HOLD_UNIFORM, mean);
+}
+
+/** Mostly small increments with occasional large ones.
+ */
+hold_dist_t * hold_dist_bimodal(double mean) {
+  return hold_dist_create(HOLD_BIMODAL, mean);
+}
+
+void hold_dist_destroy(hold_dist_t *dist) {
+  free(dist);
+}
+
+int64_t hold_dist_next(hold_dist_t *dist, uint64_t *seed) {
+  double increment = 0;
+  switch(dist->kind) {
+  case HOLD_EXPONENTIAL:
+    // 1 - u is in (0, 1], so the log is finite.
+    increment = -log(1.0 - uniform(seed)) * dist->mean;
+    break;
+  case HOLD_UNIFORM:
+    increment = 2.0 * dist->mean * uniform(seed);
+    break;
+  case HOLD_BIMODAL: {
+    double small = BIMODAL_SMALL_MEAN * dist->mean;
+    double large = (1.0 - BIMODAL_SMALL_SHARE * BIMODAL_SMALL_MEAN)
+      / (1.0 - BIMODAL_SMALL_SHARE) * dist->mean;
+    double mode = uniform(seed) < BIMODAL_SMALL_SHARE ? small : large;
+    increment = 2.0 * mode * uniform(seed);
+    break;
+  }
+  }
+  return 1 + (int64_t)increment;
+}
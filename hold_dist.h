@@ -0,0 +1,18 @@
+/* Priority increments for the hold model.
+ * Each hold operation pops the minimum priority and reinserts it plus an
+ * increment drawn from one of the classic distributions, all with the given
+ * mean.  Increments are at least 1 so a reinserted priority never collides
+ * with the one just popped.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+typedef struct hold_dist_t hold_dist_t;
+
+hold_dist_t * hold_dist_exponential(double mean);
+hold_dist_t * hold_dist_uniform(double mean);
+hold_dist_t * hold_dist_bimodal(double mean);
+void hold_dist_destroy(hold_dist_t *dist);
+int64_t hold_dist_next(hold_dist_t *dist, uint64_t *seed);
@@ -0,0 +1,144 @@
+#include "key_dist.h"
+#include <math.h>
+#include <stdlib.h>
+
+// Zeta is summed term by term, so very large key spaces draw their ranks
+// from the first ZIPF_MAX_ITEMS items and scatter them over the whole range.
+#define ZIPF_MAX_ITEMS (1 << 26)
+
+typedef enum { DIST_ZIPFIAN, DIST_HOTSPOT, DIST_LATEST } kind_t;
+
+typedef struct zipf_t zipf_t;
+
+struct zipf_t {
+  int64_t items;
+  double theta, alpha, zetan, eta, half_pow_theta;
+};
+
+struct key_dist_t {
+  kind_t kind;
+  int64_t upper_bound;
+  zipf_t zipf;
+  int64_t hot_keys;
+  double hot_ops;
+  volatile int64_t latest;
+};
+
+static uint64_t fast_rand(uint64_t *seed) {
+  uint64_t val = *seed;
+  if(val == 0) {
+    val = 1;
+  }
+  val ^= val << 6;
+  val ^= val >> 21;
+  val ^= val << 7;
+  *seed = val;
+  return val;
+}
+
+static double uniform(uint64_t *seed) {
+  return (fast_rand(seed) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// FNV-1a over the key's bytes; spreads the popular ranks over the key space.
+static uint64_t scramble(uint64_t value) {
+  uint64_t hash = 0xCBF29CE484222325ULL;
+  for(int i = 0; i < 8; i++) {
+    hash ^= value & 0xFF;
+    hash *= 0x100000001B3ULL;
+    value >>= 8;
+  }
+  return hash;
+}
+
+static void zipf_init(zipf_t *zipf, int64_t items, double theta) {
+  if(items > ZIPF_MAX_ITEMS) { items = ZIPF_MAX_ITEMS; }
+  if(items < 2) { items = 2; }
+  double zetan = 0, zeta2 = 1 + pow(0.5, theta);
+  for(int64_t i = 1; i <= items; i++) {
+    zetan += 1 / pow((double)i, theta);
+  }
+  zipf->items = items;
+  zipf->theta = theta;
+  zipf->zetan = zetan;
+  zipf->alpha = 1 / (1 - theta);
+  zipf->eta = (1 - pow(2.0 / items, 1 - theta)) / (1 - zeta2 / zetan);
+  zipf->half_pow_theta = 1 + pow(0.5, theta);
+}
+
+/** Gray et al.'s constant-time Zipfian rank in [0, items), as used by YCSB.
+ */
+static int64_t zipf_next(zipf_t *zipf, uint64_t *seed) {
+  double u = uniform(seed);
+  double uz = u * zipf->zetan;
+  if(uz < 1) { return 0; }
+  if(uz < zipf->half_pow_theta) { return 1; }
+  int64_t rank = (int64_t)(zipf->items
+    * pow(zipf->eta * u - zipf->eta + 1, zipf->alpha));
+  return rank < zipf->items ? rank : zipf->items - 1;
+}
+
+static key_dist_t * key_dist_create(kind_t kind, int64_t upper_bound) {
+  key_dist_t *dist = calloc(1, sizeof(key_dist_t));
+  dist->kind = kind;
+  dist->upper_bound = upper_bound;
+  return dist;
+}
+
+key_dist_t * key_dist_zipfian(int64_t upper_bound, double theta) {
+  key_dist_t *dist = key_dist_create(DIST_ZIPFIAN, upper_bound);
+  zipf_init(&dist->zipf, upper_bound, theta);
+  return dist;
+}
+
+/** hot_ops of the draws fall in the first hot_set of the key space.
+ */
+key_dist_t * key_dist_hotspot(int64_t upper_bound, double hot_set,
+                              double hot_ops) {
+  key_dist_t *dist = key_dist_create(DIST_HOTSPOT, upper_bound);
+  dist->hot_keys = (int64_t)(upper_bound * hot_set);
+  if(dist->hot_keys < 1) { dist->hot_keys = 1; }
+  if(dist->hot_keys > upper_bound) { dist->hot_keys = upper_bound; }
+  dist->hot_ops = hot_ops;
+  return dist;
+}
+
+/** Inserts take ascending keys after the loaded ones; every other operation
+ *  picks a Zipfian distance back from the most recent insert.
+ */
+key_dist_t * key_dist_latest(int64_t upper_bound, double theta,
+                             int64_t loaded) {
+  key_dist_t *dist = key_dist_create(DIST_LATEST, upper_bound);
+  zipf_init(&dist->zipf, loaded < upper_bound ? loaded : upper_bound, theta);
+  dist->latest = loaded;
+  return dist;
+}
+
+void key_dist_destroy(key_dist_t *dist) {
+  free(dist);
+}
+
+int64_t key_dist_next(key_dist_t *dist, uint64_t *seed, int insert) {
+  switch(dist->kind) {
+  case DIST_ZIPFIAN:
+    return scramble(zipf_next(&dist->zipf, seed)) % dist->upper_bound;
+  case DIST_HOTSPOT: {
+    int64_t cold_keys = dist->upper_bound - dist->hot_keys;
+    if(cold_keys == 0 || uniform(seed) < dist->hot_ops) {
+      return fast_rand(seed) % dist->hot_keys;
+    }
+    return dist->hot_keys + fast_rand(seed) % cold_keys;
+  }
+  case DIST_LATEST: {
+    if(insert) {
+      return __atomic_fetch_add(&dist->latest, 1, __ATOMIC_RELAXED)
+        % dist->upper_bound;
+    }
+    int64_t latest = __atomic_load_n(&dist->latest, __ATOMIC_RELAXED);
+    int64_t key = (latest - 1 - zipf_next(&dist->zipf, seed))
+      % dist->upper_bound;
+    return key < 0 ? key + dist->upper_bound : key;
+  }
+  }
+  return 0;
+}
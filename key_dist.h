@@ -0,0 +1,19 @@
+/* Skewed key distributions for the set benchmark.
+ * A distribution is built once and shared read-only by every thread (the
+ * "latest" insert cursor is the only shared mutable state); each draw uses
+ * the calling thread's own xorshift seed.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+typedef struct key_dist_t key_dist_t;
+
+key_dist_t * key_dist_zipfian(int64_t upper_bound, double theta);
+key_dist_t * key_dist_hotspot(int64_t upper_bound, double hot_set,
+                              double hot_ops);
+key_dist_t * key_dist_latest(int64_t upper_bound, double theta,
+                             int64_t loaded);
+void key_dist_destroy(key_dist_t *dist);
+int64_t key_dist_next(key_dist_t *dist, uint64_t *seed, int insert);
@@ -0,0 +1,56 @@
+#include "pacer.h"
+#include <math.h>
+#include <stdlib.h>
+
+struct pacer_t {
+  double interval_ns, due_ns;
+  int poisson;
+  uint64_t seed;
+};
+
+static uint64_t fast_rand(uint64_t *seed) {
+  uint64_t val = *seed;
+  if(val == 0) {
+    val = 1;
+  }
+  val ^= val << 6;
+  val ^= val >> 21;
+  val ^= val << 7;
+  *seed = val;
+  return val;
+}
+
+/** Create a schedule of rate operations per second.
+ */
+pacer_t * pacer_create(double rate, int poisson, uint64_t seed) {
+  pacer_t *pacer = malloc(sizeof(pacer_t));
+  pacer->interval_ns = 1e9 / rate;
+  pacer->due_ns = 0;
+  pacer->poisson = poisson;
+  pacer->seed = seed;
+  return pacer;
+}
+
+void pacer_destroy(pacer_t *pacer) {
+  free(pacer);
+}
+
+/** Restart the schedule with the first operation due at start_ns.
+ */
+void pacer_reset(pacer_t *pacer, uint64_t start_ns) {
+  pacer->due_ns = start_ns;
+}
+
+/** Return when the next operation is due and schedule the one after it.
+ */
+uint64_t pacer_next(pacer_t *pacer) {
+  uint64_t due = (uint64_t)pacer->due_ns;
+  if(pacer->poisson) {
+    // 1 - u is in (0, 1], so the log is finite.
+    double u = (fast_rand(&pacer->seed) >> 11) * (1.0 / 9007199254740992.0);
+    pacer->due_ns += -log(1.0 - u) * pacer->interval_ns;
+  } else {
+    pacer->due_ns += pacer->interval_ns;
+  }
+  return due;
+}
@@ -0,0 +1,17 @@
+/* Open-loop arrival schedule for one benchmark thread.
+ * Operations are due at a fixed interval or with exponentially distributed
+ * gaps (a Poisson process) at the given rate.  The schedule never waits for
+ * the structure, so a stalled operation delays the ones queued behind it
+ * and their latency, timed from the due time, shows the stall.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+typedef struct pacer_t pacer_t;
+
+pacer_t * pacer_create(double rate, int poisson, uint64_t seed);
+void pacer_destroy(pacer_t *pacer);
+void pacer_reset(pacer_t *pacer, uint64_t start_ns);
+uint64_t pacer_next(pacer_t *pacer);
@@ -0,0 +1,24 @@
+#!/bin/bash
+
+#  $1 is benchmark binary, $2 is structure, $3 is policy, $4 is threads,
+#  $5 is the first offered rate (ops/sec), $6 is the rate step, $7 is the last
+#  rate; any further arguments (e.g. -i, -r, -u) go to every run.
+#  Each run appends one open-loop row to the csv; the saturation knee is
+#  where the achieved ops/sec falls below offered_rate and the tail
+#  latency climbs.
+
+BINARY=$1
+STRUCTURE=$2
+POLICY=$3
+THREADS=$4
+shift 4
+FIRST=$1
+STEP=$2
+LAST=$3
+shift 3
+
+for rate in $(seq $FIRST $STEP $LAST)
+do
+  timeout --foreground 40s ./$BINARY -d 10 --csv -b $STRUCTURE -p $POLICY -t $THREADS --rate $rate "$@"
+  killall $BINARY
+done
@@ -0,0 +1,37 @@
+#!/bin/bash
+
+#  $1 is benchmark binary, $2 is structure, $3 is policy; any further
+#  arguments (e.g. -d, -i, -r, -u) go to every run.
+#  Runs the thread steps from topology.sh, one process per NUMA interleave
+#  set, sweeping that set's thread counts on a single prefilled structure.
+
+DIR=$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)
+source $DIR/topology.sh
+
+BINARY=$1
+STRUCTURE=$2
+POLICY=$3
+shift 3
+
+#  $1 is the interleave set, $2 the thread counts; the rest go to the binary.
+run_group() {
+  local nodes=$1 counts=$2
+  shift 2
+  if command -v numactl > /dev/null; then
+    numactl -i $nodes $BINARY --csv -b $STRUCTURE -p $POLICY --sweep $counts "$@"
+  else
+    $BINARY --csv -b $STRUCTURE -p $POLICY --sweep $counts "$@"
+  fi
+}
+
+NODES=""
+COUNTS=""
+while read threads nodes; do
+  if [ -n "$NODES" ] && [ "$nodes" != "$NODES" ]; then
+    run_group $NODES $COUNTS "$@"
+    COUNTS=""
+  fi
+  NODES=$nodes
+  COUNTS=${COUNTS:+$COUNTS,}$threads
+done < <(thread_steps)
+run_group $NODES $COUNTS "$@"
@@ -0,0 +1,158 @@
+#define _GNU_SOURCE
+#include "perf_counters.h"
+#include <linux/perf_event.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#define CACHE_EVENT(cache, op, result) \
+  ((cache) | ((op) << 8) | ((result) << 16))
+
+typedef struct event_t event_t;
+
+struct event_t {
+  const char *name;
+  uint32_t type;
+  uint64_t config;
+};
+
+static const event_t events[] = {
+  { "cycles-per-op", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+  { "instrs-per-op", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+  { "l1d-miss-per-op", PERF_TYPE_HW_CACHE,
+    CACHE_EVENT(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ,
+                PERF_COUNT_HW_CACHE_RESULT_MISS) },
+  { "llc-miss-per-op", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+  { "dtlb-miss-per-op", PERF_TYPE_HW_CACHE,
+    CACHE_EVENT(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ,
+                PERF_COUNT_HW_CACHE_RESULT_MISS) },
+  { "branch-miss-per-op", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+};
+
+#define EVENTS (sizeof(events) / sizeof(events[0]))
+
+struct perf_counters_t {
+  int fds[EVENTS];
+  bool available[EVENTS];
+  double values[EVENTS];
+  // Operations of the threads merged into values, per event, since a
+  // thread may fail to open some events and not others.
+  int64_t ops[EVENTS];
+};
+
+static bool warned = false;
+
+static int open_event(const event_t *event) {
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = event->type;
+  attr.config = event->config;
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format =
+    PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+perf_counters_t * perf_counters_create() {
+  perf_counters_t *counters = malloc(sizeof(perf_counters_t));
+  for(uint32_t i = 0; i < EVENTS; i++) {
+    counters->fds[i] = -1;
+    counters->available[i] = false;
+    counters->values[i] = 0.0;
+    counters->ops[i] = 0;
+  }
+  return counters;
+}
+
+/** Open the counters for the calling thread.  They start disabled.
+ */
+perf_counters_t * perf_counters_open() {
+  perf_counters_t *counters = perf_counters_create();
+  bool any = false;
+  for(uint32_t i = 0; i < EVENTS; i++) {
+    counters->fds[i] = open_event(&events[i]);
+    counters->available[i] = counters->fds[i] >= 0;
+    any |= counters->available[i];
+  }
+  if(!any && !__sync_lock_test_and_set(&warned, true)) {
+    fprintf(stderr, "warning: hardware counters unavailable; "
+            "check /proc/sys/kernel/perf_event_paranoid.\n");
+  }
+  return counters;
+}
+
+/** Enable the counters.  Counts and enabled/running times accumulate over
+ *  every start/stop window, so repeated windows sum to one total.
+ */
+void perf_counters_start(perf_counters_t *counters) {
+  for(uint32_t i = 0; i < EVENTS; i++) {
+    if(counters->fds[i] < 0) { continue; }
+    ioctl(counters->fds[i], PERF_EVENT_IOC_ENABLE, 0);
+  }
+}
+
+/** Disable the counters and read the running totals, scaling for any time
+ *  the kernel multiplexed a counter off the PMU.
+ */
+void perf_counters_stop(perf_counters_t *counters) {
+  for(uint32_t i = 0; i < EVENTS; i++) {
+    if(counters->fds[i] < 0) { continue; }
+    ioctl(counters->fds[i], PERF_EVENT_IOC_DISABLE, 0);
+    uint64_t data[3];
+    if(read(counters->fds[i], data, sizeof(data)) != sizeof(data)
+      || data[2] == 0) {
+      counters->available[i] = false;
+      continue;
+    }
+    counters->values[i] = (double)data[0] * ((double)data[1] / data[2]);
+  }
+}
+
+/** Add the counts of a thread that ran ops operations.
+ */
+void perf_counters_merge(perf_counters_t *into, perf_counters_t *from,
+                         int64_t ops) {
+  for(uint32_t i = 0; i < EVENTS; i++) {
+    if(!from->available[i]) { continue; }
+    into->available[i] = true;
+    into->values[i] += from->values[i];
+    into->ops[i] += ops;
+  }
+}
+
+void perf_counters_destroy(perf_counters_t *counters) {
+  for(uint32_t i = 0; i < EVENTS; i++) {
+    if(counters->fds[i] >= 0) { close(counters->fds[i]); }
+  }
+  free(counters);
+}
+
+void perf_counters_print(perf_counters_t *counters) {
+  for(uint32_t i = 0; i < EVENTS; i++) {
+    if(counters->available[i] && counters->ops[i] > 0) {
+      printf("  %-19s: %.3f\n", events[i].name,
+             counters->values[i] / counters->ops[i]);
+    } else {
+      printf("  %-19s: n/a\n", events[i].name);
+    }
+  }
+}
+
+/** Append the per-operation counts as CSV columns; unavailable counters
+ *  are written as -1.
+ */
+void perf_counters_fprint_csv(FILE *data, perf_counters_t *counters) {
+  for(uint32_t i = 0; i < EVENTS; i++) {
+    if(counters->available[i] && counters->ops[i] > 0) {
+      fprintf(data, ", %.3f", counters->values[i] / counters->ops[i]);
+    } else {
+      fprintf(data, ", -1");
+    }
+  }
+}
@@ -0,0 +1,22 @@
+/* Per-thread hardware performance counters via perf_event_open.
+ * Counters are opened by, and count only, the calling thread.  Any counter
+ * the kernel refuses (no PMU access, perf_event_paranoid, unsupported event)
+ * is reported as unavailable instead of failing the benchmark.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+
+typedef struct perf_counters_t perf_counters_t;
+
+perf_counters_t * perf_counters_create();
+perf_counters_t * perf_counters_open();
+void perf_counters_start(perf_counters_t *counters);
+void perf_counters_stop(perf_counters_t *counters);
+void perf_counters_merge(perf_counters_t *into, perf_counters_t *from,
+                         int64_t ops);
+void perf_counters_destroy(perf_counters_t *counters);
+void perf_counters_print(perf_counters_t *counters);
+void perf_counters_fprint_csv(FILE *data, perf_counters_t *counters);
@@ -1,4 +1,6 @@
-import sys, os, glob, re
+from __future__ import print_function, division
+
+import sys, os, glob, re, math, argparse
 
 import matplotlib.ticker as plticker
 import matplotlib.pyplot as plt
@@ -254,6 +256,159 @@ def parse_file(key, data):
     lang_policy_results.append((int(result[keys['threads']]), float(result[keys['ops/sec']]) / 1000000))
   return perf_results
 
+# Columns that, with the structure, policy and thread count, identify the
+# workload of a row; whichever a file has are used.
+workload_keys = ['init_size', 'upper_bound', 'update_rate', 'insert_share',
+                 'workload', 'key_dist', 'theta', 'producers', 'consumers',
+                 'hold', 'increment', 'offered_rate', 'arrivals',
+                 'footprint', 'inputs', 'stall_ms', 'stall_every_ms',
+                 'stall_threads', 'backoff', 'backoff_max', 'oversubscribe',
+                 'pin']
+
+def incomplete_beta(a, b, x):
+  # Regularised incomplete beta I_x(a, b) by Lentz's continued fraction.
+  if x <= 0.0 or x >= 1.0:
+    return max(0.0, min(1.0, x))
+  if x > (a + 1.0) / (a + b + 2.0):
+    return 1.0 - incomplete_beta(b, a, 1.0 - x)
+  front = math.exp(math.lgamma(a + b) - math.lgamma(a) - math.lgamma(b)
+                   + a * math.log(x) + b * math.log(1.0 - x)) / a
+  tiny = 1e-300
+  c, d = 1.0, 1.0 - (a + b) * x / (a + 1.0)
+  d = 1.0 / (d if abs(d) > tiny else tiny)
+  result = d
+  for m in range(1, 200):
+    for numerator in (m * (b - m) * x / ((a + 2 * m - 1) * (a + 2 * m)),
+                      -(a + m) * (a + b + m) * x / ((a + 2 * m) * (a + 2 * m + 1))):
+      d = 1.0 + numerator * d
+      d = 1.0 / (d if abs(d) > tiny else tiny)
+      c = 1.0 + numerator / c
+      c = c if abs(c) > tiny else tiny
+      result *= c * d
+    if abs(c * d - 1.0) < 1e-12:
+      break
+  return front * result
+
+def welch_p_value(base, cand):
+  # Two-sided p-value of Welch's t-test on (mean, stddev, n) summaries.
+  (m1, s1, n1), (m2, s2, n2) = base, cand
+  if n1 < 2 or n2 < 2:
+    return None
+  v1, v2 = s1 * s1 / n1, s2 * s2 / n2
+  if v1 + v2 == 0.0:
+    return 0.0 if m1 != m2 else 1.0
+  t = (m2 - m1) / math.sqrt(v1 + v2)
+  df = (v1 + v2) ** 2 / (v1 * v1 / (n1 - 1) + v2 * v2 / (n2 - 1))
+  return incomplete_beta(df / 2.0, 0.5, df / (df + t * t))
+
+def find_result_files(directory, prefix):
+  # A results directory holds the csv files itself or, as written by
+  # run_topology_sweep.sh, under sets/ and pqueues/.
+  for sub in ['', 'sets', 'pqueues']:
+    key = os.path.join(directory, sub, prefix + '_keys.csv')
+    data = os.path.join(directory, sub, prefix + '_data.csv')
+    if os.path.exists(key) and os.path.exists(data):
+      return (key, data)
+  return None
+
+def summarise_cells(directory):
+  # Map each (suite, structure, policy, threads, workload) cell to the
+  # (mean, stddev, n) of its ops/sec.  Several rows for a cell are
+  # independent runs; a single row stands on its own repetitions.
+  cells = {}
+  for prefix in ['set', 'pqueue', 'micro']:
+    files = find_result_files(directory, prefix)
+    if files is None:
+      continue
+    with open(files[0], 'r') as open_file:
+      keys = dict((key.strip(), idx) for idx, key
+                  in enumerate(open_file.readline().split(',')))
+    present = [key for key in workload_keys if key in keys]
+    rows = {}
+    with open(files[1], 'r') as open_file:
+      for line in open_file:
+        result = [x.strip() for x in line.split(',')]
+        if len(result) < len(keys):
+          continue
+        workload = ' '.join(key + '=' + result[keys[key]] for key in present)
+        cell = (prefix, result[keys['benchmark']], result[keys['policy']],
+                int(result[keys['threads']]), workload)
+        reps, stddev = 1, 0.0
+        if 'reps' in keys:
+          reps = int(result[keys['reps']])
+          stddev = float(result[keys['ops/sec_stddev']])
+        rows.setdefault(cell, []).append(
+          (float(result[keys['ops/sec']]), stddev, reps))
+    for cell, samples in rows.items():
+      if len(samples) > 1:
+        values = [sample[0] for sample in samples]
+        mu = mean(values)
+        var = sum((x - mu) ** 2 for x in values) / (len(values) - 1)
+        cells[cell] = (mu, math.sqrt(var), len(values))
+      else:
+        cells[cell] = samples[0]
+  return cells
+
+def compare(argv):
+  parser = argparse.ArgumentParser(
+    prog = 'performance_csv.py compare',
+    description = 'Compare the throughput of two result directories.')
+  parser.add_argument('baseline')
+  parser.add_argument('candidate')
+  parser.add_argument('--threshold', type = float, default = 5.0,
+                      help = 'percent drop that counts as a regression (default 5)')
+  parser.add_argument('--alpha', type = float, default = 0.05,
+                      help = 'significance level of the t-test (default 0.05)')
+  parser.add_argument('--csv', help = 'also write the table to this file')
+  args = parser.parse_args(argv)
+
+  base_cells = summarise_cells(args.baseline)
+  cand_cells = summarise_cells(args.candidate)
+  common = sorted(set(base_cells) & set(cand_cells))
+  if not common:
+    print('error: the result sets have no configuration in common.')
+    return 2
+
+  rows = []
+  for cell in common:
+    base, cand = base_cells[cell], cand_cells[cell]
+    change = (cand[0] - base[0]) / base[0] * 100.0 if base[0] > 0 else 0.0
+    p = welch_p_value(base, cand)
+    significant = p is not None and p < args.alpha
+    if change <= -args.threshold and significant:
+      verdict = 'REGRESSION'
+    elif change <= -args.threshold:
+      verdict = 'slower?'
+    elif change >= args.threshold and significant:
+      verdict = 'improved'
+    else:
+      verdict = ''
+    rows.append(cell + (base[0], cand[0], change, p, verdict))
+
+  header = ('suite', 'structure', 'policy', 'threads', 'base ops/sec',
+            'cand ops/sec', 'change %', 'p', 'verdict', 'workload')
+  line = '{:<7} {:<10} {:<7} {:>7} {:>14} {:>14} {:>9} {:>7}  {:<10} {}'
+  print(line.format(*header))
+  for (suite, structure, policy, threads, workload,
+       base, cand, change, p, verdict) in rows:
+    print(line.format(suite, structure, policy, threads, '%.0f' % base,
+                      '%.0f' % cand, '%+.1f' % change,
+                      '-' if p is None else '%.3f' % p, verdict, workload))
+  if args.csv:
+    with open(args.csv, 'w') as open_file:
+      open_file.write(', '.join(header) + '\n')
+      for (suite, structure, policy, threads, workload,
+           base, cand, change, p, verdict) in rows:
+        open_file.write('%s, %s, %s, %d, %.0f, %.0f, %.2f, %s, %s, %s\n' % (
+          suite, structure, policy, threads, base, cand, change,
+          '' if p is None else '%.4f' % p, verdict, workload))
+
+  regressions = sum(1 for row in rows if row[-1] == 'REGRESSION')
+  print('')
+  print('%d configurations compared, %d only in one set, %d regressions.' % (
+    len(rows), len(set(base_cells) ^ set(cand_cells)), regressions))
+  return 1 if regressions > 0 else 0
+
 
 def main():
   if not os.path.exists('figures'):
@@ -275,4 +430,7 @@ def main():
     
    
 if __name__ == '__main__':
+  # performance_csv.py compare <baseline> <candidate>: exit 1 on a regression.
+  if len(sys.argv) > 1 and sys.argv[1] == 'compare':
+    sys.exit(compare(sys.argv[2:]))
   main()
@@ -0,0 +1,167 @@
+#include "rank_log.h"
+#include "utils.h"
+#include <stdlib.h>
+
+typedef struct entry_t entry_t;
+
+struct entry_t {
+  uint64_t ns;
+  int64_t key;
+  int32_t op;
+};
+
+struct rank_stream_t {
+  entry_t *entries;
+  uint64_t length, capacity;
+};
+
+struct rank_log_t {
+  int32_t thread_count;
+  rank_stream_t *streams;
+  int64_t pops, inversions, unmatched;
+  double rank_sum;
+};
+
+rank_log_t * rank_log_create(int32_t thread_count) {
+  rank_log_t *log = calloc(1, sizeof(rank_log_t));
+  log->thread_count = thread_count;
+  log->streams = calloc(thread_count, sizeof(rank_stream_t));
+  return log;
+}
+
+void rank_log_destroy(rank_log_t *log) {
+  for(int32_t i = 0; i < log->thread_count; i++) {
+    free(log->streams[i].entries);
+  }
+  free(log->streams);
+  free(log);
+}
+
+rank_stream_t * rank_log_stream(rank_log_t *log, int32_t id) {
+  return &log->streams[id % log->thread_count];
+}
+
+/** Log a successful operation; the timestamp is taken here, as the
+ *  operation returns.
+ */
+void rank_stream_append(rank_stream_t *stream, int32_t op, int64_t key) {
+  if(stream->length == stream->capacity) {
+    stream->capacity = stream->capacity == 0 ? 4096 : stream->capacity * 2;
+    stream->entries = realloc(stream->entries,
+                              sizeof(entry_t) * stream->capacity);
+  }
+  stream->entries[stream->length++] = (entry_t){ clock_ns(), key, op };
+}
+
+static int compare_entries(const void *a, const void *b) {
+  const entry_t *x = a, *y = b;
+  if(x->ns != y->ns) { return x->ns < y->ns ? -1 : 1; }
+  // On a tie let the insert go first, so a pop can find it.
+  return x->op - y->op;
+}
+
+static int compare_keys(const void *a, const void *b) {
+  int64_t x = *(const int64_t*)a, y = *(const int64_t*)b;
+  return x < y ? -1 : x > y;
+}
+
+static int64_t key_index(int64_t *keys, int64_t count, int64_t key) {
+  int64_t low = 0, high = count - 1;
+  while(low < high) {
+    int64_t mid = (low + high) / 2;
+    if(keys[mid] < key) { low = mid + 1; } else { high = mid; }
+  }
+  return low;
+}
+
+// Fenwick tree over the distinct keys, counting the keys present.
+static void tree_add(int64_t *tree, int64_t count, int64_t index,
+                     int64_t delta) {
+  for(index++; index <= count; index += index & -index) {
+    tree[index] += delta;
+  }
+}
+
+static int64_t tree_prefix(int64_t *tree, int64_t index) {
+  int64_t sum = 0;
+  for(; index > 0; index -= index & -index) {
+    sum += tree[index];
+  }
+  return sum;
+}
+
+/** Replay the merged log and record the rank error of every pop in ranks.
+ *  Completion stamps from different cores can order a pop before the
+ *  insert of the key it returned; such a pop is counted as unmatched and
+ *  the late insert is dropped.  Return the number of pops replayed.
+ */
+int64_t rank_log_analyse(rank_log_t *log, histogram_t *ranks) {
+  uint64_t length = 0;
+  for(int32_t i = 0; i < log->thread_count; i++) {
+    length += log->streams[i].length;
+  }
+  entry_t *merged = malloc(sizeof(entry_t) * (length + 1));
+  int64_t *keys = malloc(sizeof(int64_t) * (length + 1));
+  uint64_t n = 0;
+  for(int32_t i = 0; i < log->thread_count; i++) {
+    rank_stream_t *stream = &log->streams[i];
+    for(uint64_t j = 0; j < stream->length; j++, n++) {
+      merged[n] = stream->entries[j];
+      keys[n] = stream->entries[j].key;
+    }
+  }
+  qsort(merged, length, sizeof(entry_t), compare_entries);
+  qsort(keys, length, sizeof(int64_t), compare_keys);
+  int64_t distinct = 0;
+  for(uint64_t i = 0; i < length; i++) {
+    if(distinct == 0 || keys[distinct - 1] != keys[i]) {
+      keys[distinct++] = keys[i];
+    }
+  }
+
+  int64_t *tree = calloc(distinct + 1, sizeof(int64_t));
+  int64_t *present = calloc(distinct + 1, sizeof(int64_t));
+  int64_t *owed = calloc(distinct + 1, sizeof(int64_t));
+  log->pops = log->inversions = log->unmatched = 0;
+  log->rank_sum = 0.0;
+  for(uint64_t i = 0; i < length; i++) {
+    int64_t index = key_index(keys, distinct, merged[i].key);
+    if(merged[i].op == RANK_LOG_INSERT) {
+      if(owed[index] > 0) {
+        owed[index]--;
+      } else {
+        present[index]++;
+        tree_add(tree, distinct, index, 1);
+      }
+    } else if(present[index] == 0) {
+      owed[index]++;
+      log->unmatched++;
+    } else {
+      int64_t rank = tree_prefix(tree, index);
+      histogram_record(ranks, rank);
+      log->pops++;
+      log->rank_sum += rank;
+      if(rank > 0) { log->inversions++; }
+      present[index]--;
+      tree_add(tree, distinct, index, -1);
+    }
+  }
+  free(merged);
+  free(keys);
+  free(tree);
+  free(present);
+  free(owed);
+  return log->pops;
+}
+
+int64_t rank_log_inversions(rank_log_t *log) {
+  return log->inversions;
+}
+
+int64_t rank_log_unmatched(rank_log_t *log) {
+  return log->unmatched;
+}
+
+double rank_log_mean(rank_log_t *log) {
+  return log->pops == 0 ? 0.0 : log->rank_sum / log->pops;
+}
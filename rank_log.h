@@ -0,0 +1,27 @@
+/* Linearization logs for measuring the quality of relaxed priority queues.
+ * Each thread appends its successful inserts and pops, stamped with the
+ * time they completed, to its own stream.  After the run the streams are
+ * merged in time order and replayed against an exact ordered multiset; the
+ * rank error of a pop is the number of smaller priorities present when it
+ * completed, and a pop with a nonzero rank error is an inversion.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "histogram.h"
+
+#define RANK_LOG_INSERT 1
+#define RANK_LOG_POP 2
+
+typedef struct rank_log_t rank_log_t;
+typedef struct rank_stream_t rank_stream_t;
+
+rank_log_t * rank_log_create(int32_t thread_count);
+void rank_log_destroy(rank_log_t *log);
+rank_stream_t * rank_log_stream(rank_log_t *log, int32_t id);
+void rank_stream_append(rank_stream_t *stream, int32_t op, int64_t key);
+int64_t rank_log_analyse(rank_log_t *log, histogram_t *ranks);
+int64_t rank_log_inversions(rank_log_t *log);
+int64_t rank_log_unmatched(rank_log_t *log);
+double rank_log_mean(rank_log_t *log);
@@ -0,0 +1,79 @@
+#define _GNU_SOURCE
+#include "reclaim_stats.h"
+#include "utils.h"
+#include <pthread.h>
+#include <signal.h>
+#include <stddef.h>
+
+static struct sigaction wrapped[NSIG];
+static __thread int64_t signals = 0, stall_ns = 0;
+
+static volatile int64_t collections = 0;
+static uint64_t fork_start = 0;
+static histogram_t *fork_pause = NULL;
+
+static void stall_handler(int signo, siginfo_t *info, void *context) {
+  uint64_t start = clock_ns();
+  struct sigaction *previous = &wrapped[signo];
+  if(previous->sa_flags & SA_SIGINFO) {
+    previous->sa_sigaction(signo, info, context);
+  } else {
+    previous->sa_handler(signo);
+  }
+  stall_ns += clock_ns() - start;
+  signals++;
+}
+
+static int wrap_signal(int signo) {
+  struct sigaction current;
+  if(sigaction(signo, NULL, &current) != 0) { return 0; }
+  if(!(current.sa_flags & SA_SIGINFO)
+    && (current.sa_handler == SIG_DFL || current.sa_handler == SIG_IGN)) {
+    return 0;
+  }
+  wrapped[signo] = current;
+  struct sigaction replacement = current;
+  replacement.sa_flags |= SA_SIGINFO;
+  replacement.sa_sigaction = stall_handler;
+  return sigaction(signo, &replacement, NULL) == 0;
+}
+
+// Only one collection runs at a time, so the fork callbacks do not race.
+static void before_fork() {
+  fork_start = clock_ns();
+}
+
+static void after_fork_parent() {
+  histogram_record(fork_pause, clock_ns() - fork_start);
+  collections++;
+}
+
+/** Install the fork hooks and wrap the reclamation signal handlers.
+ *  Returns the number of signal handlers wrapped; zero means stall time
+ *  cannot be observed.
+ */
+int reclaim_stats_init() {
+  fork_pause = histogram_create();
+  pthread_atfork(before_fork, after_fork_parent, NULL);
+  int handlers = wrap_signal(SIGUSR1) + wrap_signal(SIGUSR2);
+  for(int signo = SIGRTMIN; signo <= SIGRTMAX; signo++) {
+    handlers += wrap_signal(signo);
+  }
+  return handlers;
+}
+
+int64_t reclaim_stats_thread_signals() {
+  return signals;
+}
+
+int64_t reclaim_stats_thread_stall_ns() {
+  return stall_ns;
+}
+
+int64_t reclaim_stats_collections() {
+  return collections;
+}
+
+histogram_t * reclaim_stats_fork_pause() {
+  return fork_pause;
+}
@@ -0,0 +1,17 @@
+/* Observes Forkscan collections from the outside.
+ * Every collection forks the process, so pthread_atfork handlers count the
+ * cycles and time the fork pause.  Threads are stopped by a signal while the
+ * fork happens; the handlers already installed for the user signals are
+ * wrapped so the time each thread spends inside them can be accumulated.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "histogram.h"
+
+int reclaim_stats_init();
+int64_t reclaim_stats_thread_signals();
+int64_t reclaim_stats_thread_stall_ns();
+int64_t reclaim_stats_collections();
+histogram_t * reclaim_stats_fork_pause();
@@ -0,0 +1,87 @@
+#include "rep_stats.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct rep_stats_t {
+  int32_t count, capacity;
+  double *samples;
+};
+
+// Two-sided 95% critical values of Student's t for 1..30 degrees of freedom.
+static const double t_95[] = {
+  12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+  2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+  2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+};
+
+static int compare_doubles(const void *a, const void *b) {
+  double x = *(const double*)a, y = *(const double*)b;
+  return (x > y) - (x < y);
+}
+
+rep_stats_t * rep_stats_create(int32_t reps) {
+  rep_stats_t *stats = malloc(sizeof(rep_stats_t));
+  stats->count = 0;
+  stats->capacity = reps;
+  stats->samples = malloc(sizeof(double) * reps);
+  return stats;
+}
+
+void rep_stats_destroy(rep_stats_t *stats) {
+  free(stats->samples);
+  free(stats);
+}
+
+void rep_stats_record(rep_stats_t *stats, double sample) {
+  if(stats->count == stats->capacity) { return; }
+  stats->samples[stats->count++] = sample;
+}
+
+int32_t rep_stats_count(rep_stats_t *stats) {
+  return stats->count;
+}
+
+double rep_stats_mean(rep_stats_t *stats) {
+  if(stats->count == 0) { return 0; }
+  double sum = 0;
+  for(int32_t i = 0; i < stats->count; i++) {
+    sum += stats->samples[i];
+  }
+  return sum / stats->count;
+}
+
+double rep_stats_median(rep_stats_t *stats) {
+  if(stats->count == 0) { return 0; }
+  double *sorted = malloc(sizeof(double) * stats->count);
+  memcpy(sorted, stats->samples, sizeof(double) * stats->count);
+  qsort(sorted, stats->count, sizeof(double), compare_doubles);
+  int32_t middle = stats->count / 2;
+  double median = sorted[middle];
+  if(stats->count % 2 == 0) {
+    median = (sorted[middle - 1] + sorted[middle]) / 2;
+  }
+  free(sorted);
+  return median;
+}
+
+/** Sample standard deviation; zero with fewer than two repetitions.
+ */
+double rep_stats_stddev(rep_stats_t *stats) {
+  if(stats->count < 2) { return 0; }
+  double mean = rep_stats_mean(stats), sum = 0;
+  for(int32_t i = 0; i < stats->count; i++) {
+    double diff = stats->samples[i] - mean;
+    sum += diff * diff;
+  }
+  return sqrt(sum / (stats->count - 1));
+}
+
+/** Half-width of the 95% confidence interval around the mean.
+ */
+double rep_stats_ci95(rep_stats_t *stats) {
+  if(stats->count < 2) { return 0; }
+  int32_t df = stats->count - 1;
+  double t = df <= 30 ? t_95[df - 1] : 1.960;
+  return t * rep_stats_stddev(stats) / sqrt(stats->count);
+}
\ No newline at end of file
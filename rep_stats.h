@@ -0,0 +1,19 @@
+/* Summary statistics over benchmark repetitions.
+ * Each repetition records one throughput sample; the median, standard
+ * deviation and a Student-t 95% confidence interval are reported at the end.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+typedef struct rep_stats_t rep_stats_t;
+
+rep_stats_t * rep_stats_create(int32_t reps);
+void rep_stats_destroy(rep_stats_t *stats);
+void rep_stats_record(rep_stats_t *stats, double sample);
+int32_t rep_stats_count(rep_stats_t *stats);
+double rep_stats_mean(rep_stats_t *stats);
+double rep_stats_median(rep_stats_t *stats);
+double rep_stats_stddev(rep_stats_t *stats);
+double rep_stats_ci95(rep_stats_t *stats);
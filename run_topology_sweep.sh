@@ -0,0 +1,56 @@
+#!/bin/bash
+
+#  $1 is the set benchmark binary, $2 is the pqueue benchmark binary, $3 is
+#  the output directory (default = results/<host>-<S>s<C>c<T>t).
+#  Runs the set and pqueue suites over the thread steps of this machine.
+#  Each suite appends its csv files in its own subdirectory, so runs from
+#  different hardware generations sit side by side under one naming scheme.
+
+DIR=$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)
+source $DIR/topology.sh
+
+SET_BINARY=$(realpath $1)
+PQUEUE_BINARY=$(realpath $2)
+OUT=$(realpath -m ${3:-results/$(hostname -s)-${SOCKETS}s${CORES_PER_SOCKET}c${THREADS_PER_CORE}t})
+
+SKIPLIST_SIZE=1280000
+SKIPLIST_RANGE=2560000
+
+BINARY_TREE_SIZE=1280000
+BINARY_TREE_RANGE=2560000
+
+HASH_TABLE_SIZE=3200000
+HASH_TABLE_RANGE=6400000
+
+PQUEUE_SIZE=1280000
+PQUEUE_RANGE=2560000
+
+mkdir -p $OUT/sets $OUT/pqueues
+$DIR/topology.sh > $OUT/topology.txt
+
+cd $OUT/sets
+# Lock-Free Skip List
+$DIR/param_topology_benchmark.sh $SET_BINARY fhsl_lf leaky -d 20 -i $SKIPLIST_SIZE -r $SKIPLIST_RANGE -u 10
+$DIR/param_topology_benchmark.sh $SET_BINARY fhsl_lf retire -d 20 -i $SKIPLIST_SIZE -r $SKIPLIST_RANGE -u 10
+$DIR/param_topology_benchmark.sh $SET_BINARY c_fhsl_lf leaky -d 20 -i $SKIPLIST_SIZE -r $SKIPLIST_RANGE -u 10
+
+# Lock-Free Binary Tree
+$DIR/param_topology_benchmark.sh $SET_BINARY bt_lf leaky -d 20 -i $BINARY_TREE_SIZE -r $BINARY_TREE_RANGE -u 10
+$DIR/param_topology_benchmark.sh $SET_BINARY bt_lf retire -d 20 -i $BINARY_TREE_SIZE -r $BINARY_TREE_RANGE -u 10
+$DIR/param_topology_benchmark.sh $SET_BINARY c_bt_lf leaky -d 20 -i $BINARY_TREE_SIZE -r $BINARY_TREE_RANGE -u 10
+
+# Maged Michael Hash Table
+$DIR/param_topology_benchmark.sh $SET_BINARY mm_ht leaky -d 20 -i $HASH_TABLE_SIZE -r $HASH_TABLE_RANGE -u 10
+$DIR/param_topology_benchmark.sh $SET_BINARY mm_ht retire -d 20 -i $HASH_TABLE_SIZE -r $HASH_TABLE_RANGE -u 10
+$DIR/param_topology_benchmark.sh $SET_BINARY c_mm_ht leaky -d 20 -i $HASH_TABLE_SIZE -r $HASH_TABLE_RANGE -u 10
+
+cd $OUT/pqueues
+# Linden Jonsson Queue
+$DIR/param_topology_benchmark.sh $PQUEUE_BINARY lj_pq leaky -d 5 -i $PQUEUE_SIZE -r $PQUEUE_RANGE
+$DIR/param_topology_benchmark.sh $PQUEUE_BINARY lj_pq retire -d 5 -i $PQUEUE_SIZE -r $PQUEUE_RANGE
+$DIR/param_topology_benchmark.sh $PQUEUE_BINARY c_lj_pq leaky -d 5 -i $PQUEUE_SIZE -r $PQUEUE_RANGE
+
+# SprayList Queue
+$DIR/param_topology_benchmark.sh $PQUEUE_BINARY spray leaky -d 5 -i $PQUEUE_SIZE -r $PQUEUE_RANGE
+$DIR/param_topology_benchmark.sh $PQUEUE_BINARY spray retire -d 5 -i $PQUEUE_SIZE -r $PQUEUE_RANGE
+$DIR/param_topology_benchmark.sh $PQUEUE_BINARY c_spray leaky -d 5 -i $PQUEUE_SIZE -r $PQUEUE_RANGE
@@ -0,0 +1,121 @@
+#define _GNU_SOURCE
+#include "sampler.h"
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define CACHE_LINE 64
+
+typedef struct slot_t slot_t;
+typedef struct sample_t sample_t;
+
+struct slot_t {
+  volatile uint64_t ops;
+  char padding[CACHE_LINE - sizeof(uint64_t)];
+};
+
+struct sample_t {
+  double time_s;
+  uint64_t ops;
+};
+
+struct sampler_t {
+  int32_t thread_count, interval_ms;
+  slot_t *slots;
+  volatile bool running;
+  pthread_t monitor;
+  uint64_t sample_count, max_samples;
+  sample_t *samples;
+};
+
+static double timespec_seconds(struct timespec *ts) {
+  return ts->tv_sec + ts->tv_nsec / 1e9;
+}
+
+static uint64_t total_ops(sampler_t *sampler) {
+  uint64_t ops = 0;
+  for(int32_t i = 0; i < sampler->thread_count; i++) {
+    ops += sampler->slots[i].ops;
+  }
+  return ops;
+}
+
+static void *monitor(void *arg) {
+  sampler_t *sampler = arg;
+  struct timespec start, next;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  next = start;
+  while(sampler->running && sampler->sample_count < sampler->max_samples) {
+    next.tv_nsec += (long)sampler->interval_ms * 1000000L;
+    while(next.tv_nsec >= 1000000000L) {
+      next.tv_nsec -= 1000000000L;
+      next.tv_sec++;
+    }
+    // Absolute deadlines keep the interval stable across Forkscan signals.
+    while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL) == EINTR);
+    sample_t *sample = &sampler->samples[sampler->sample_count];
+    sample->ops = total_ops(sampler);
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    sample->time_s = timespec_seconds(&now) - timespec_seconds(&start);
+    sampler->sample_count++;
+  }
+  return NULL;
+}
+
+sampler_t * sampler_create(int32_t thread_count, int32_t interval_ms,
+                           int32_t duration_s) {
+  sampler_t *sampler = malloc(sizeof(sampler_t));
+  sampler->thread_count = thread_count;
+  sampler->interval_ms = interval_ms;
+  sampler->slots = aligned_alloc(CACHE_LINE, sizeof(slot_t) * thread_count);
+  memset(sampler->slots, 0, sizeof(slot_t) * thread_count);
+  sampler->running = false;
+  sampler->sample_count = 0;
+  // Room for the whole run plus a few samples of slack while threads stop.
+  sampler->max_samples = ((uint64_t)duration_s * 1000) / interval_ms + 16;
+  sampler->samples = malloc(sizeof(sample_t) * sampler->max_samples);
+  return sampler;
+}
+
+void sampler_destroy(sampler_t *sampler) {
+  free(sampler->samples);
+  free(sampler->slots);
+  free(sampler);
+}
+
+volatile uint64_t * sampler_slot(sampler_t *sampler, int32_t id) {
+  return &sampler->slots[id].ops;
+}
+
+void sampler_start(sampler_t *sampler) {
+  sampler->running = true;
+  if(pthread_create(&sampler->monitor, NULL, monitor, sampler) != 0) {
+    fprintf(stderr, "error: failed to create sampling thread.\n");
+    exit(1);
+  }
+}
+
+void sampler_stop(sampler_t *sampler) {
+  sampler->running = false;
+  pthread_join(sampler->monitor, NULL);
+}
+
+void sampler_write_csv(sampler_t *sampler, FILE *data,
+                       const char *benchmark, const char *policy) {
+  double last_time = 0.0;
+  uint64_t last_ops = 0;
+  for(uint64_t i = 0; i < sampler->sample_count; i++) {
+    sample_t *sample = &sampler->samples[i];
+    double interval = sample->time_s - last_time;
+    uint64_t ops = sample->ops - last_ops;
+    fprintf(data, "%s, %s, %d, %.3f, %lu, %lu\n",
+            benchmark, policy, sampler->thread_count, sample->time_s, ops,
+            interval > 0.0 ? (uint64_t)(ops / interval) : 0);
+    last_time = sample->time_s;
+    last_ops = sample->ops;
+  }
+}
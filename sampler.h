@@ -0,0 +1,21 @@
+/* Time-series throughput sampler.
+ * Each benchmark thread publishes its running operation count to its own
+ * cache-line padded slot; a monitor thread snapshots the slots at a fixed
+ * interval so throughput can be plotted over the course of a run.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+
+typedef struct sampler_t sampler_t;
+
+sampler_t * sampler_create(int32_t thread_count, int32_t interval_ms,
+                           int32_t duration_s);
+void sampler_destroy(sampler_t *sampler);
+volatile uint64_t * sampler_slot(sampler_t *sampler, int32_t id);
+void sampler_start(sampler_t *sampler);
+void sampler_stop(sampler_t *sampler);
+void sampler_write_csv(sampler_t *sampler, FILE *data,
+                       const char *benchmark, const char *policy);
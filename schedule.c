@@ -0,0 +1,207 @@
+#include "schedule.h"
+#include <ctype.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct phase_t phase_t;
+
+struct phase_t {
+  int32_t duration_s, update_rate, insert_share;
+  int64_t key_offset, key_range;
+  char *key_dist;
+};
+
+struct schedule_t {
+  int32_t count, capacity;
+  phase_t *phases;
+};
+
+static const char *key_dists[] = { "uniform", "zipfian", "hotspot", "latest" };
+
+static char * read_file(const char *path) {
+  FILE *file = fopen(path, "r");
+  if(file == NULL) {
+    fprintf(stderr, "error: cannot open schedule %s.\n", path);
+    return NULL;
+  }
+  size_t length = 0, capacity = 4096;
+  char *text = malloc(capacity);
+  size_t n;
+  while((n = fread(text + length, 1, capacity - length - 1, file)) > 0) {
+    length += n;
+    if(length + 1 == capacity) {
+      capacity *= 2;
+      text = realloc(text, capacity);
+    }
+  }
+  fclose(file);
+  text[length] = '\0';
+  return text;
+}
+
+static char * trim(char *text) {
+  while(isspace((unsigned char)*text)) { text++; }
+  char *end = text + strlen(text);
+  while(end > text && isspace((unsigned char)end[-1])) { end--; }
+  *end = '\0';
+  return text;
+}
+
+static int parse_int(const char *value, int64_t low, int64_t high,
+                     int64_t *out) {
+  char *end;
+  errno = 0;
+  long long n = strtoll(value, &end, 10);
+  if(errno != 0 || end == value || *end != '\0' || n < low || n > high) {
+    return -1;
+  }
+  *out = n;
+  return 0;
+}
+
+/** Parse one key=value field into phase.  Return -1, after printing why,
+ *  on an unknown key or a value out of range.
+ */
+static int parse_field(phase_t *phase, char *field) {
+  char *eq = strchr(field, '=');
+  if(eq == NULL) {
+    fprintf(stderr, "error: schedule field '%s' is not key=value.\n", field);
+    return -1;
+  }
+  *eq = '\0';
+  char *key = trim(field), *value = trim(eq + 1);
+  int64_t n = 0;
+  int status = 0;
+  if(strcmp(key, "d") == 0) {
+    status = parse_int(value, 1, INT32_MAX, &n);
+    phase->duration_s = n;
+  } else if(strcmp(key, "u") == 0) {
+    status = parse_int(value, 0, 100, &n);
+    phase->update_rate = n;
+  } else if(strcmp(key, "i") == 0) {
+    status = parse_int(value, 0, 100, &n);
+    phase->insert_share = n;
+  } else if(strcmp(key, "off") == 0) {
+    status = parse_int(value, 0, INT64_MAX >> 2, &n);
+    phase->key_offset = n;
+  } else if(strcmp(key, "range") == 0) {
+    status = parse_int(value, 1, INT64_MAX >> 2, &n);
+    phase->key_range = n;
+  } else if(strcmp(key, "dist") == 0) {
+    status = -1;
+    for(size_t i = 0; i < sizeof(key_dists) / sizeof(key_dists[0]); i++) {
+      if(strcmp(value, key_dists[i]) == 0) { status = 0; }
+    }
+    if(status == 0) {
+      free(phase->key_dist);
+      phase->key_dist = strdup(value);
+    }
+  } else {
+    fprintf(stderr, "error: unknown schedule field '%s'.\n", key);
+    return -1;
+  }
+  if(status != 0) {
+    fprintf(stderr, "error: bad value '%s' for schedule field '%s'.\n",
+            value, key);
+  }
+  return status;
+}
+
+static int parse_phase(schedule_t *schedule, char *text) {
+  text = trim(text);
+  if(*text == '\0') { return 0; }
+  phase_t phase = { 0, -1, -1, 0, -1, NULL };
+  char *save = NULL;
+  for(char *field = strtok_r(text, ",", &save); field != NULL;
+      field = strtok_r(NULL, ",", &save)) {
+    if(parse_field(&phase, field) != 0) {
+      free(phase.key_dist);
+      return -1;
+    }
+  }
+  if(phase.duration_s == 0) {
+    fprintf(stderr, "error: schedule phase %d has no duration (d=<s>).\n",
+            schedule->count + 1);
+    free(phase.key_dist);
+    return -1;
+  }
+  if(schedule->count == schedule->capacity) {
+    schedule->capacity *= 2;
+    schedule->phases = realloc(schedule->phases,
+                               sizeof(phase_t) * schedule->capacity);
+  }
+  schedule->phases[schedule->count++] = phase;
+  return 0;
+}
+
+/** Parse a schedule from spec, or from the file it names after an '@'.
+ *  Return NULL, after printing why, if it is malformed or empty.
+ */
+schedule_t * schedule_parse(const char *spec) {
+  char *text = spec[0] == '@' ? read_file(spec + 1) : strdup(spec);
+  if(text == NULL) { return NULL; }
+
+  // Comments run to the end of their line.
+  for(char *hash = strchr(text, '#'); hash != NULL; hash = strchr(hash, '#')) {
+    while(*hash != '\0' && *hash != '\n') { *hash++ = ' '; }
+  }
+
+  schedule_t *schedule = malloc(sizeof(schedule_t));
+  schedule->count = 0;
+  schedule->capacity = 8;
+  schedule->phases = malloc(sizeof(phase_t) * schedule->capacity);
+  char *save = NULL;
+  for(char *phase = strtok_r(text, ";\n", &save); phase != NULL;
+      phase = strtok_r(NULL, ";\n", &save)) {
+    if(parse_phase(schedule, phase) != 0) {
+      free(text);
+      schedule_destroy(schedule);
+      return NULL;
+    }
+  }
+  free(text);
+  if(schedule->count == 0) {
+    fprintf(stderr, "error: schedule has no phases.\n");
+    schedule_destroy(schedule);
+    return NULL;
+  }
+  return schedule;
+}
+
+void schedule_destroy(schedule_t *schedule) {
+  for(int32_t i = 0; i < schedule->count; i++) {
+    free(schedule->phases[i].key_dist);
+  }
+  free(schedule->phases);
+  free(schedule);
+}
+
+int32_t schedule_phase_count(schedule_t *schedule) {
+  return schedule->count;
+}
+
+int32_t schedule_duration(schedule_t *schedule, int32_t phase) {
+  return schedule->phases[phase].duration_s;
+}
+
+int32_t schedule_update_rate(schedule_t *schedule, int32_t phase) {
+  return schedule->phases[phase].update_rate;
+}
+
+int32_t schedule_insert_share(schedule_t *schedule, int32_t phase) {
+  return schedule->phases[phase].insert_share;
+}
+
+int64_t schedule_key_offset(schedule_t *schedule, int32_t phase) {
+  return schedule->phases[phase].key_offset;
+}
+
+int64_t schedule_key_range(schedule_t *schedule, int32_t phase) {
+  return schedule->phases[phase].key_range;
+}
+
+const char * schedule_key_dist(schedule_t *schedule, int32_t phase) {
+  return schedule->phases[phase].key_dist;
+}
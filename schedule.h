@@ -0,0 +1,25 @@
+/* Phased workload schedules.
+ * A schedule is a sequence of timed phases, each of which may override the
+ * update mix, the key window and the key distribution of the run.  Phases
+ * are separated by ';' or newlines and hold comma-separated key=value
+ * fields, e.g. "d=10,u=0;d=5,u=100,i=0,off=0;d=10,u=50,off=256".  A spec
+ * starting with '@' names a file holding one phase per line, with '#'
+ * comments.  Fields a phase leaves out read as -1 (or NULL) and inherit the
+ * command line settings.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+typedef struct schedule_t schedule_t;
+
+schedule_t * schedule_parse(const char *spec);
+void schedule_destroy(schedule_t *schedule);
+int32_t schedule_phase_count(schedule_t *schedule);
+int32_t schedule_duration(schedule_t *schedule, int32_t phase);
+int32_t schedule_update_rate(schedule_t *schedule, int32_t phase);
+int32_t schedule_insert_share(schedule_t *schedule, int32_t phase);
+int64_t schedule_key_offset(schedule_t *schedule, int32_t phase);
+int64_t schedule_key_range(schedule_t *schedule, int32_t phase);
+const char * schedule_key_dist(schedule_t *schedule, int32_t phase);
@@ -0,0 +1,63 @@
+#include "seq_heap.h"
+#include "seq_ht.h"
+#include <forkscan.h>
+#include <string.h>
+
+struct seq_heap_t {
+  uint64_t count, capacity;
+  int64_t *keys;
+  seq_ht_t *members;
+};
+
+/** Return an empty heap with room for size priorities before it grows.
+ */
+seq_heap_t * seq_heap_create(uint64_t size) {
+  seq_heap_t *pqueue = forkscan_malloc(sizeof(seq_heap_t));
+  pqueue->count = 0;
+  pqueue->capacity = size < 16 ? 16 : size;
+  pqueue->keys = forkscan_malloc(sizeof(int64_t) * pqueue->capacity);
+  pqueue->members = seq_ht_create(size);
+  return pqueue;
+}
+
+int seq_heap_add(seq_heap_t *pqueue, int64_t key) {
+  if(!seq_ht_add(pqueue->members, key)) {
+    return 0;
+  }
+  if(pqueue->count == pqueue->capacity) {
+    int64_t *keys = forkscan_malloc(sizeof(int64_t) * 2 * pqueue->capacity);
+    memcpy(keys, pqueue->keys, sizeof(int64_t) * pqueue->count);
+    forkscan_free(pqueue->keys);
+    pqueue->keys = keys;
+    pqueue->capacity *= 2;
+  }
+  uint64_t i = pqueue->count++;
+  while(i > 0 && pqueue->keys[(i - 1) / 2] > key) {
+    pqueue->keys[i] = pqueue->keys[(i - 1) / 2];
+    i = (i - 1) / 2;
+  }
+  pqueue->keys[i] = key;
+  return 1;
+}
+
+int seq_heap_pop_min(seq_heap_t *pqueue, int64_t *priority) {
+  if(pqueue->count == 0) {
+    return 0;
+  }
+  int64_t *keys = pqueue->keys;
+  int64_t top = keys[0], last = keys[--pqueue->count];
+  uint64_t i = 0, size = pqueue->count;
+  while(2 * i + 1 < size) {
+    uint64_t child = 2 * i + 1;
+    if(child + 1 < size && keys[child + 1] < keys[child]) {
+      child++;
+    }
+    if(keys[child] >= last) { break; }
+    keys[i] = keys[child];
+    i = child;
+  }
+  keys[i] = last;
+  seq_ht_remove(pqueue->members, top);
+  *priority = top;
+  return 1;
+}
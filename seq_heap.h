@@ -0,0 +1,17 @@
+#pragma once
+
+/* A sequential binary heap priority queue written in C.
+ * The single-threaded baseline for the concurrent priority queues.  The
+ * queues in this repository hold each priority at most once, so the heap
+ * keeps a seq_ht index of the priorities it holds and refuses duplicates
+ * the same way.  The heap array doubles when full.
+ */
+
+#include <stdint.h>
+
+typedef struct seq_heap_t seq_heap_t;
+
+seq_heap_t * seq_heap_create(uint64_t size);
+
+int seq_heap_add(seq_heap_t *pqueue, int64_t key);
+int seq_heap_pop_min(seq_heap_t *pqueue, int64_t *priority);
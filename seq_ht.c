@@ -0,0 +1,107 @@
+#include "seq_ht.h"
+#include <forkscan.h>
+#include <stdbool.h>
+
+// No benchmark key is negative, so the most negative one marks a free slot.
+#define EMPTY INT64_MIN
+
+struct seq_ht_t {
+  int32_t bits;
+  uint64_t mask, count;
+  int64_t *slots;
+};
+
+static uint64_t home(seq_ht_t *set, int64_t key) {
+  return ((uint64_t)key * 0x9E3779B97F4A7C15ull) >> (64 - set->bits);
+}
+
+static void allocate(seq_ht_t *set, int32_t bits) {
+  set->bits = bits;
+  set->mask = ((uint64_t)1 << bits) - 1;
+  set->slots = forkscan_malloc(sizeof(int64_t) << bits);
+  for(uint64_t i = 0; i <= set->mask; i++) {
+    set->slots[i] = EMPTY;
+  }
+}
+
+/** Return the slot holding key, or the free slot that ends its probe run.
+ */
+static uint64_t probe(seq_ht_t *set, int64_t key) {
+  uint64_t i = home(set, key);
+  while(set->slots[i] != EMPTY && set->slots[i] != key) {
+    i = (i + 1) & set->mask;
+  }
+  return i;
+}
+
+static void grow(seq_ht_t *set) {
+  int64_t *old = set->slots;
+  uint64_t old_size = set->mask + 1;
+  allocate(set, set->bits + 1);
+  for(uint64_t i = 0; i < old_size; i++) {
+    if(old[i] != EMPTY) {
+      set->slots[probe(set, old[i])] = old[i];
+    }
+  }
+  forkscan_free(old);
+}
+
+/** Return a table with room for size keys before it first grows.
+ */
+seq_ht_t * seq_ht_create(uint64_t size) {
+  seq_ht_t *set = forkscan_malloc(sizeof(seq_ht_t));
+  int32_t bits = 4;
+  while(((uint64_t)1 << bits) < 2 * size) {
+    bits++;
+  }
+  allocate(set, bits);
+  set->count = 0;
+  return set;
+}
+
+void seq_ht_destroy(seq_ht_t *set) {
+  forkscan_free(set->slots);
+  forkscan_free(set);
+}
+
+int seq_ht_contains(seq_ht_t *set, int64_t key) {
+  return set->slots[probe(set, key)] == key;
+}
+
+int seq_ht_add(seq_ht_t *set, int64_t key) {
+  uint64_t i = probe(set, key);
+  if(set->slots[i] == key) {
+    return 0;
+  }
+  if(2 * (set->count + 1) > set->mask + 1) {
+    grow(set);
+    i = probe(set, key);
+  }
+  set->slots[i] = key;
+  set->count++;
+  return 1;
+}
+
+int seq_ht_remove(seq_ht_t *set, int64_t key) {
+  uint64_t hole = probe(set, key);
+  if(set->slots[hole] != key) {
+    return 0;
+  }
+  // Shift later members of the run back over the hole whenever the hole
+  // lies between their home slot and where they sit.
+  uint64_t i = hole;
+  while(true) {
+    i = (i + 1) & set->mask;
+    if(set->slots[i] == EMPTY) {
+      break;
+    }
+    uint64_t want = home(set, set->slots[i]);
+    if(((i - want) & set->mask) >= ((i - hole) & set->mask)) {
+      set->slots[hole] = set->slots[i];
+      hole = i;
+    }
+  }
+  set->slots[hole] = EMPTY;
+  set->count--;
+  return 1;
+}
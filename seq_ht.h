@@ -0,0 +1,19 @@
+#pragma once
+
+/* A sequential open-addressing hash table written in C.
+ * The single-threaded baseline for the lock-free hash tables: linear
+ * probing over a power-of-two array of keys with Fibonacci hashing,
+ * backward-shift deletion so no tombstones build up, and doubling once the
+ * table is half full.
+ */
+
+#include <stdint.h>
+
+typedef struct seq_ht_t seq_ht_t;
+
+seq_ht_t * seq_ht_create(uint64_t size);
+void seq_ht_destroy(seq_ht_t *set);
+
+int seq_ht_contains(seq_ht_t *set, int64_t key);
+int seq_ht_add(seq_ht_t *set, int64_t key);
+int seq_ht_remove(seq_ht_t *set, int64_t key);
@@ -0,0 +1,248 @@
+#include "seq_rbt.h"
+#include <forkscan.h>
+#include <stdbool.h>
+
+typedef struct node_t node_t;
+
+struct node_t {
+  int64_t key;
+  bool red;
+  node_t *left, *right, *parent;
+};
+
+struct seq_rbt_t {
+  node_t *root;
+  node_t nil;
+};
+
+static void rotate_left(seq_rbt_t *tree, node_t *x) {
+  node_t *y = x->right;
+  x->right = y->left;
+  if(y->left != &tree->nil) {
+    y->left->parent = x;
+  }
+  y->parent = x->parent;
+  if(x->parent == &tree->nil) {
+    tree->root = y;
+  } else if(x == x->parent->left) {
+    x->parent->left = y;
+  } else {
+    x->parent->right = y;
+  }
+  y->left = x;
+  x->parent = y;
+}
+
+static void rotate_right(seq_rbt_t *tree, node_t *x) {
+  node_t *y = x->left;
+  x->left = y->right;
+  if(y->right != &tree->nil) {
+    y->right->parent = x;
+  }
+  y->parent = x->parent;
+  if(x->parent == &tree->nil) {
+    tree->root = y;
+  } else if(x == x->parent->right) {
+    x->parent->right = y;
+  } else {
+    x->parent->left = y;
+  }
+  y->right = x;
+  x->parent = y;
+}
+
+static void insert_fixup(seq_rbt_t *tree, node_t *z) {
+  while(z->parent->red) {
+    node_t *grand = z->parent->parent;
+    if(z->parent == grand->left) {
+      node_t *uncle = grand->right;
+      if(uncle->red) {
+        z->parent->red = false;
+        uncle->red = false;
+        grand->red = true;
+        z = grand;
+      } else {
+        if(z == z->parent->right) {
+          z = z->parent;
+          rotate_left(tree, z);
+        }
+        z->parent->red = false;
+        z->parent->parent->red = true;
+        rotate_right(tree, z->parent->parent);
+      }
+    } else {
+      node_t *uncle = grand->left;
+      if(uncle->red) {
+        z->parent->red = false;
+        uncle->red = false;
+        grand->red = true;
+        z = grand;
+      } else {
+        if(z == z->parent->left) {
+          z = z->parent;
+          rotate_right(tree, z);
+        }
+        z->parent->red = false;
+        z->parent->parent->red = true;
+        rotate_left(tree, z->parent->parent);
+      }
+    }
+  }
+  tree->root->red = false;
+}
+
+/** Put v in u's place under u's parent.  The sentinel's parent is written
+ *  too, as remove_fixup starts from it when v is a leaf.
+ */
+static void transplant(seq_rbt_t *tree, node_t *u, node_t *v) {
+  if(u->parent == &tree->nil) {
+    tree->root = v;
+  } else if(u == u->parent->left) {
+    u->parent->left = v;
+  } else {
+    u->parent->right = v;
+  }
+  v->parent = u->parent;
+}
+
+static void remove_fixup(seq_rbt_t *tree, node_t *x) {
+  while(x != tree->root && !x->red) {
+    if(x == x->parent->left) {
+      node_t *w = x->parent->right;
+      if(w->red) {
+        w->red = false;
+        x->parent->red = true;
+        rotate_left(tree, x->parent);
+        w = x->parent->right;
+      }
+      if(!w->left->red && !w->right->red) {
+        w->red = true;
+        x = x->parent;
+      } else {
+        if(!w->right->red) {
+          w->left->red = false;
+          w->red = true;
+          rotate_right(tree, w);
+          w = x->parent->right;
+        }
+        w->red = x->parent->red;
+        x->parent->red = false;
+        w->right->red = false;
+        rotate_left(tree, x->parent);
+        x = tree->root;
+      }
+    } else {
+      node_t *w = x->parent->left;
+      if(w->red) {
+        w->red = false;
+        x->parent->red = true;
+        rotate_right(tree, x->parent);
+        w = x->parent->left;
+      }
+      if(!w->right->red && !w->left->red) {
+        w->red = true;
+        x = x->parent;
+      } else {
+        if(!w->left->red) {
+          w->right->red = false;
+          w->red = true;
+          rotate_left(tree, w);
+          w = x->parent->left;
+        }
+        w->red = x->parent->red;
+        x->parent->red = false;
+        w->left->red = false;
+        rotate_right(tree, x->parent);
+        x = tree->root;
+      }
+    }
+  }
+  x->red = false;
+}
+
+static node_t * find(seq_rbt_t *tree, int64_t key) {
+  node_t *node = tree->root;
+  while(node != &tree->nil && node->key != key) {
+    node = key < node->key ? node->left : node->right;
+  }
+  return node;
+}
+
+/** Return a new, empty tree.
+ */
+seq_rbt_t * seq_rbt_create() {
+  seq_rbt_t *tree = forkscan_malloc(sizeof(seq_rbt_t));
+  tree->nil.key = 0;
+  tree->nil.red = false;
+  tree->nil.left = tree->nil.right = tree->nil.parent = &tree->nil;
+  tree->root = &tree->nil;
+  return tree;
+}
+
+int seq_rbt_contains(seq_rbt_t *tree, int64_t key) {
+  return find(tree, key) != &tree->nil;
+}
+
+int seq_rbt_add(seq_rbt_t *tree, int64_t key) {
+  node_t *parent = &tree->nil, *node = tree->root;
+  while(node != &tree->nil) {
+    if(key == node->key) {
+      return 0;
+    }
+    parent = node;
+    node = key < node->key ? node->left : node->right;
+  }
+  node_t *z = forkscan_malloc(sizeof(node_t));
+  z->key = key;
+  z->red = true;
+  z->left = z->right = &tree->nil;
+  z->parent = parent;
+  if(parent == &tree->nil) {
+    tree->root = z;
+  } else if(key < parent->key) {
+    parent->left = z;
+  } else {
+    parent->right = z;
+  }
+  insert_fixup(tree, z);
+  return 1;
+}
+
+int seq_rbt_remove(seq_rbt_t *tree, int64_t key) {
+  node_t *z = find(tree, key);
+  if(z == &tree->nil) {
+    return 0;
+  }
+  node_t *x, *y = z;
+  bool removed_red = y->red;
+  if(z->left == &tree->nil) {
+    x = z->right;
+    transplant(tree, z, z->right);
+  } else if(z->right == &tree->nil) {
+    x = z->left;
+    transplant(tree, z, z->left);
+  } else {
+    y = z->right;
+    while(y->left != &tree->nil) {
+      y = y->left;
+    }
+    removed_red = y->red;
+    x = y->right;
+    if(y->parent == z) {
+      x->parent = y;
+    } else {
+      transplant(tree, y, y->right);
+      y->right = z->right;
+      y->right->parent = y;
+    }
+    transplant(tree, z, y);
+    y->left = z->left;
+    y->left->parent = y;
+    y->red = z->red;
+  }
+  if(!removed_red) {
+    remove_fixup(tree, x);
+  }
+  forkscan_free(z);
+  return 1;
+}
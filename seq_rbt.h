@@ -0,0 +1,17 @@
+#pragma once
+
+/* A sequential red-black tree written in C.
+ * The single-threaded baseline for the lock-free binary trees: a balanced
+ * internal tree with parent pointers and a shared black sentinel for the
+ * leaves, as in CLRS.  Removed nodes are freed at once.
+ */
+
+#include <stdint.h>
+
+typedef struct seq_rbt_t seq_rbt_t;
+
+seq_rbt_t * seq_rbt_create();
+
+int seq_rbt_contains(seq_rbt_t *set, int64_t key);
+int seq_rbt_add(seq_rbt_t *set, int64_t key);
+int seq_rbt_remove(seq_rbt_t *set, int64_t key);
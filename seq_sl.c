@@ -0,0 +1,117 @@
+#include "seq_sl.h"
+#include <forkscan.h>
+
+#define LEVELS 20
+
+typedef struct node_t node_t;
+
+struct node_t {
+  int64_t key;
+  node_t *next[];
+};
+
+struct seq_sl_t {
+  node_t *head;
+};
+
+static uint64_t fast_rand(uint64_t *seed) {
+  uint64_t val = *seed;
+  if(val == 0) {
+    val = 1;
+  }
+  val ^= val << 6;
+  val ^= val >> 21;
+  val ^= val << 7;
+  *seed = val;
+  return val;
+}
+
+static int32_t random_level(uint64_t *seed) {
+  int32_t level = 1;
+  while(fast_rand(seed) % 2 == 0 && level < LEVELS) {
+    level++;
+  }
+  return level;
+}
+
+/** Allocate a node linked at levels 0 .. height - 1.  Nodes are sized to
+ *  their height, as a sequential list has no need for in-place growth.
+ */
+static node_t * node_create(int64_t key, int32_t height) {
+  node_t *node = forkscan_malloc(sizeof(node_t) + height * sizeof(node_t *));
+  node->key = key;
+  return node;
+}
+
+/** Fill preds with the last node before key at each level and return the
+ *  first node at or after key on the bottom level.
+ */
+static node_t * find(seq_sl_t *set, int64_t key, node_t **preds) {
+  node_t *pred = set->head;
+  for(int32_t level = LEVELS - 1; level >= 0; level--) {
+    node_t *curr = pred->next[level];
+    while(curr != NULL && curr->key < key) {
+      pred = curr;
+      curr = curr->next[level];
+    }
+    preds[level] = pred;
+  }
+  return pred->next[0];
+}
+
+/** Return a new, empty skip list.
+ */
+seq_sl_t * seq_sl_create() {
+  seq_sl_t *set = forkscan_malloc(sizeof(seq_sl_t));
+  set->head = node_create(INT64_MIN, LEVELS);
+  for(int32_t level = 0; level < LEVELS; level++) {
+    set->head->next[level] = NULL;
+  }
+  return set;
+}
+
+int seq_sl_contains(seq_sl_t *set, int64_t key) {
+  node_t *pred = set->head;
+  for(int32_t level = LEVELS - 1; level >= 0; level--) {
+    node_t *curr = pred->next[level];
+    while(curr != NULL && curr->key < key) {
+      pred = curr;
+      curr = curr->next[level];
+    }
+    if(curr != NULL && curr->key == key) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+int seq_sl_add(uint64_t *seed, seq_sl_t *set, int64_t key) {
+  node_t *preds[LEVELS];
+  node_t *found = find(set, key, preds);
+  if(found != NULL && found->key == key) {
+    return 0;
+  }
+  int32_t height = random_level(seed);
+  node_t *node = node_create(key, height);
+  for(int32_t level = 0; level < height; level++) {
+    node->next[level] = preds[level]->next[level];
+    preds[level]->next[level] = node;
+  }
+  return 1;
+}
+
+int seq_sl_remove(seq_sl_t *set, int64_t key) {
+  node_t *preds[LEVELS];
+  node_t *found = find(set, key, preds);
+  if(found == NULL || found->key != key) {
+    return 0;
+  }
+  for(int32_t level = 0; level < LEVELS; level++) {
+    if(preds[level]->next[level] != found) {
+      break;
+    }
+    preds[level]->next[level] = found->next[level];
+  }
+  forkscan_free(found);
+  return 1;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+/* A sequential skip list written in C.
+ * The single-threaded baseline for the lock-free skip lists: the same
+ * fixed height and level distribution as c_fhsl_lf, but plain loads and
+ * stores, no marked pointers, and removed nodes are freed at once.
+ */
+
+#include <stdint.h>
+
+typedef struct seq_sl_t seq_sl_t;
+
+seq_sl_t * seq_sl_create();
+
+int seq_sl_contains(seq_sl_t *set, int64_t key);
+int seq_sl_add(uint64_t *seed, seq_sl_t *set, int64_t key);
+int seq_sl_remove(seq_sl_t *set, int64_t key);
@@ -0,0 +1,79 @@
+#include "stall_inject.h"
+#include "utils.h"
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+
+#ifdef STALL_INJECTION
+
+static volatile uint64_t generation = 0;
+static volatile int running = 0;
+static int32_t period_ms = 0, duration_ms = 0;
+static pthread_t timer;
+
+static __thread int armed = 0;
+static __thread uint64_t seen = 0;
+static __thread int64_t stalls = 0, stalled_ns = 0;
+
+// Sleep through the signals Forkscan sends to collect.
+static void sleep_ms(int32_t ms) {
+  struct timespec remaining = { ms / 1000, (ms % 1000) * 1000000L };
+  while(nanosleep(&remaining, &remaining) != 0 && errno == EINTR) {}
+}
+
+static void * timer_thread(void *arg) {
+  while(running) {
+    sleep_ms(period_ms);
+    generation++;
+  }
+  return NULL;
+}
+
+int stall_enabled() { return 1; }
+
+void stall_start(int32_t period, int32_t duration) {
+  period_ms = period;
+  duration_ms = duration;
+  running = 1;
+  pthread_create(&timer, NULL, timer_thread, NULL);
+}
+
+void stall_stop() {
+  if(!running) { return; }
+  running = 0;
+  pthread_join(timer, NULL);
+}
+
+/** Make the calling thread one of the threads that stall.  Requests raised
+ *  before this call are ignored.
+ */
+void stall_thread_arm() {
+  armed = 1;
+  seen = generation;
+}
+
+void stall_point() {
+  if(armed && generation != seen) {
+    seen = generation;
+    uint64_t start = clock_ns();
+    sleep_ms(duration_ms);
+    stalled_ns += clock_ns() - start;
+    stalls++;
+  }
+}
+
+int64_t stall_thread_count() { return stalls; }
+int64_t stall_thread_ns() { return stalled_ns; }
+
+#else
+
+int stall_enabled() { return 0; }
+void stall_start(int32_t period, int32_t duration) {}
+void stall_stop() {}
+void stall_thread_arm() {}
+void stall_point() {}
+
+int64_t stall_thread_count() { return 0; }
+int64_t stall_thread_ns() { return 0; }
+
+#endif
@@ -0,0 +1,23 @@
+/* Stalled-thread injection for reclamation robustness runs.
+ * A timer thread raises a stall request every period; each armed worker
+ * thread that reaches a stall point in a data-structure traversal while a
+ * request is outstanding sleeps for the stall duration, still holding the
+ * references it has read, as a descheduled reader would.  The stall points
+ * are compiled in only when STALL_INJECTION is defined (build with
+ * `make STALLS=1`).  Otherwise stall_point() is empty, the Makefile links
+ * its body into the DEF structures that call it so the call folds away,
+ * and stall_enabled() returns 0.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+int stall_enabled();
+void stall_start(int32_t period_ms, int32_t duration_ms);
+void stall_stop();
+void stall_thread_arm();
+void stall_point();
+
+int64_t stall_thread_count();
+int64_t stall_thread_ns();
@@ -6,13 +6,28 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <unistd.h>
 
 typedef struct socket_t socket_t;
 
+enum { PIN_SOCKET, PIN_COMPACT, PIN_SCATTER, PIN_CORES, PIN_LIST };
+
+static const char *policies[] = { "socket", "compact", "scatter", "cores" };
+
+static int policy = PIN_SOCKET;
+
+// The CPUs named by the list policy, in order.
+#define MAX_LISTED 1024
+static uint32_t listed[MAX_LISTED];
+static uint32_t num_listed = 0;
+
 struct thread_pinner_t {
   uint32_t current_socket, num_sockets;
   socket_t *sockets;
+  // The order the policy hands out CPUs in, and the next one to hand out.
+  uint32_t *cpus;
+  uint32_t num_cpus, next_cpu;
 };
 
 struct socket_t {
@@ -64,6 +79,143 @@ static void print_socket(socket_t *my_socket) {
   printf("********************\n");
 }
 
+/** Parse a CPU list such as "0-3,8,10-11" into listed.  Return -1 if it
+ *  is malformed, names more than MAX_LISTED CPUs, or names a CPU this
+ *  process cannot run on; a thread pinned there would get an empty or
+ *  refused affinity mask.
+ */
+static int parse_list(const char *text) {
+  cpu_set_t usable;
+  if(sched_getaffinity(0, sizeof(usable), &usable) != 0) { return -1; }
+  num_listed = 0;
+  while(*text) {
+    char *end;
+    long first = strtol(text, &end, 10), last = first;
+    if(end == text || first < 0) { return -1; }
+    if(*end == '-') {
+      text = end + 1;
+      last = strtol(text, &end, 10);
+      if(end == text || last < first) { return -1; }
+    }
+    for(long cpu = first; cpu <= last; cpu++) {
+      if(num_listed == MAX_LISTED) { return -1; }
+      if(cpu >= CPU_SETSIZE || !CPU_ISSET(cpu, &usable)) {
+        fprintf(stderr, "error: CPU %ld is offline or not available to "
+                "this process.\n", cpu);
+        return -1;
+      }
+      listed[num_listed++] = cpu;
+    }
+    if(*end == ',') {
+      end++;
+    } else if(*end != '\0') {
+      return -1;
+    }
+    text = end;
+  }
+  return num_listed == 0 ? -1 : 0;
+}
+
+int thread_pinner_select(const char *name) {
+  for(size_t i = 0; i < sizeof(policies) / sizeof(policies[0]); i++) {
+    if(strcmp(name, policies[i]) == 0) {
+      policy = i;
+      return 0;
+    }
+  }
+  if(parse_list(name) != 0) { return -1; }
+  policy = PIN_LIST;
+  return 0;
+}
+
+const char * thread_pinner_policy() {
+  return policy == PIN_LIST ? "list" : policies[policy];
+}
+
+static uint32_t linux_id(uint32_t processor) {
+  return cpuinfo_get_processor(processor)->linux_id;
+}
+
+/** Append the first processor of each core of socket, then the second of
+ *  each, and so on, so every physical core has a thread before any core
+ *  has two.
+ */
+static uint32_t socket_cores_first(const struct cpuinfo_cluster *socket,
+                                   uint32_t *cpus) {
+  uint32_t count = 0;
+  for(uint32_t smt = 0; count < socket->processor_count; smt++) {
+    for(uint32_t i = 0; i < socket->core_count; i++) {
+      const struct cpuinfo_core *core = cpuinfo_get_core(socket->core_start + i);
+      if(smt < core->processor_count) {
+        cpus[count++] = linux_id(core->processor_start + smt);
+      }
+    }
+  }
+  return count;
+}
+
+static void order_cpus(thread_pinner_t *pinner) {
+  uint32_t total = cpuinfo_get_processors_count();
+  const struct cpuinfo_cluster *sockets = cpuinfo_get_clusters();
+  pinner->cpus = malloc(sizeof(uint32_t) * (total > num_listed ? total : num_listed));
+  pinner->num_cpus = 0;
+  pinner->next_cpu = 0;
+  switch(policy) {
+  case PIN_SOCKET:
+    // Fill one socket before the next, in the populate_socket order.
+    for(uint32_t i = 0; i < pinner->num_sockets; i++) {
+      socket_t *socket = &pinner->sockets[i];
+      for(uint32_t j = 0; j < socket->num_processors; j++) {
+        pinner->cpus[pinner->num_cpus++] = socket->processor_queue[j];
+      }
+    }
+    break;
+  case PIN_COMPACT:
+    // SMT siblings back to back, then the next core, then the next socket.
+    for(uint32_t i = 0; i < total; i++) {
+      pinner->cpus[pinner->num_cpus++] = linux_id(i);
+    }
+    break;
+  case PIN_SCATTER: {
+    // Deal the cores-first order of each socket round robin over sockets.
+    uint32_t **orders = malloc(sizeof(uint32_t *) * pinner->num_sockets);
+    uint32_t most = 0;
+    for(uint32_t i = 0; i < pinner->num_sockets; i++) {
+      orders[i] = malloc(sizeof(uint32_t) * sockets[i].processor_count);
+      socket_cores_first(&sockets[i], orders[i]);
+      if(sockets[i].processor_count > most) { most = sockets[i].processor_count; }
+    }
+    for(uint32_t j = 0; j < most; j++) {
+      for(uint32_t i = 0; i < pinner->num_sockets; i++) {
+        if(j < sockets[i].processor_count) {
+          pinner->cpus[pinner->num_cpus++] = orders[i][j];
+        }
+      }
+    }
+    for(uint32_t i = 0; i < pinner->num_sockets; i++) { free(orders[i]); }
+    free(orders);
+    break;
+  }
+  case PIN_CORES: {
+    // One thread per physical core over the machine, then the siblings.
+    uint32_t cores = cpuinfo_get_cores_count();
+    for(uint32_t smt = 0; pinner->num_cpus < total; smt++) {
+      for(uint32_t i = 0; i < cores; i++) {
+        const struct cpuinfo_core *core = cpuinfo_get_core(i);
+        if(smt < core->processor_count) {
+          pinner->cpus[pinner->num_cpus++] = linux_id(core->processor_start + smt);
+        }
+      }
+    }
+    break;
+  }
+  case PIN_LIST:
+    memcpy(pinner->cpus, listed, sizeof(uint32_t) * num_listed);
+    pinner->num_cpus = num_listed;
+    break;
+  }
+}
+
 thread_pinner_t * thread_pinner_create() {
   assert(cpuinfo_initialize());
   thread_pinner_t * pinner = malloc(sizeof(thread_pinner_t));
@@ -92,17 +244,22 @@ thread_pinner_t * thread_pinner_create() {
       populate_socket(&pinner->sockets[current_socket], socket);
       // print_socket(&pinner->sockets[current_socket]);
   }
+  order_cpus(pinner);
   return pinner;
 }
 
-static int pin_thread_to_socket(socket_t *socket, pthread_t thread) {
-  if(socket->current_processor == socket->num_processors) { return false; }
-  cpu_set_t cpu_set;
-  CPU_ZERO(&cpu_set);
-  uint32_t core_id = socket->processor_queue[socket->current_processor++];
-  CPU_SET(core_id, &cpu_set);
-  // printf("Pinning thread to processor: %d\n", core_id);
-  return pthread_setaffinity_np(thread, sizeof(cpu_set_t), &cpu_set) == 0;
+int thread_pinner_cpus(thread_pinner_t *thread_pinner) {
+  return thread_pinner->num_cpus;
+}
+
+/** Claim the next CPU of the pinner's order into cpu_set.  Return false
+ *  once every CPU has a thread.
+ */
+static bool next_cpu_set(thread_pinner_t *thread_pinner, cpu_set_t *cpu_set) {
+  if(thread_pinner->next_cpu == thread_pinner->num_cpus) { return false; }
+  CPU_ZERO(cpu_set);
+  CPU_SET(thread_pinner->cpus[thread_pinner->next_cpu++], cpu_set);
+  return true;
 }
 
 int get_num_cores() {
@@ -110,11 +267,24 @@ int get_num_cores() {
 }
 
 int pin_thread(thread_pinner_t * thread_pinner, pthread_t thread) {
-  for(uint32_t current_socket = 0;
-    current_socket < thread_pinner->num_sockets;
-    current_socket++) {
-    if(pin_thread_to_socket(&thread_pinner->sockets[current_socket],
-      thread)) { return 0; }
+  cpu_set_t cpu_set;
+  if(!next_cpu_set(thread_pinner, &cpu_set)) { return 1; }
+  return pthread_setaffinity_np(thread, sizeof(cpu_set_t), &cpu_set) == 0 ? 0 : 1;
+}
+
+int pinned_thread_create(thread_pinner_t *thread_pinner, pthread_t *thread,
+                         void *(*start)(void *), void *arg) {
+  if(thread_pinner == NULL) {
+    return pthread_create(thread, NULL, start, arg);
   }
-  return 1;
-}
\ No newline at end of file
+  cpu_set_t cpu_set;
+  if(!next_cpu_set(thread_pinner, &cpu_set)) { return -1; }
+  pthread_attr_t attr;
+  pthread_attr_init(&attr);
+  int ret = pthread_attr_setaffinity_np(&attr, sizeof(cpu_set_t), &cpu_set);
+  if(ret == 0) {
+    ret = pthread_create(thread, &attr, start, arg);
+  }
+  pthread_attr_destroy(&attr);
+  return ret;
+}
@@ -1,7 +1,27 @@
 #include <pthread.h>
 
+/* Pins threads to CPUs in an order picked at run time for the process:
+ *   socket  - fill one socket before the next, each physical core before
+ *             its SMT siblings (the default);
+ *   compact - SMT siblings back to back, then the next core and socket;
+ *   scatter - round robin over the sockets, cores before siblings;
+ *   cores   - every physical core on the machine before any sibling;
+ *   a CPU list such as "0-3,8" - exactly those CPUs, in that order.
+ * Each pinner hands out every CPU of the order once.
+ */
+
 typedef struct thread_pinner_t thread_pinner_t;
 
+int thread_pinner_select(const char *policy);
+const char * thread_pinner_policy();
+
 thread_pinner_t * thread_pinner_create();
+int thread_pinner_cpus(thread_pinner_t *thread_pinner);
 int get_num_cores();
-int pin_thread(thread_pinner_t *thread_pinner, pthread_t thread);
\ No newline at end of file
+int pin_thread(thread_pinner_t *thread_pinner, pthread_t thread);
+
+// Start the thread already bound to the next CPU, so it never runs
+// elsewhere.  A nil pinner starts it unpinned.  Return -1 once every CPU
+// has a thread, or else pthread_create's result.
+int pinned_thread_create(thread_pinner_t *thread_pinner, pthread_t *thread,
+                         void *(*start)(void *), void *arg);
@@ -0,0 +1,64 @@
+#include "thread_sweep.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct thread_sweep_t {
+  int32_t count;
+  int32_t *threads;
+};
+
+/** Parse a list of thread counts, each in [1, max_threads].  Return NULL,
+ *  after printing why, if it is malformed or empty.
+ */
+thread_sweep_t * thread_sweep_parse(const char *spec, int32_t max_threads) {
+  char *text = strdup(spec);
+  thread_sweep_t *sweep = malloc(sizeof(thread_sweep_t));
+  sweep->count = 0;
+  sweep->threads = malloc(sizeof(int32_t) * (strlen(spec) / 2 + 1));
+  char *save = NULL;
+  for(char *field = strtok_r(text, ",", &save); field != NULL;
+      field = strtok_r(NULL, ",", &save)) {
+    char *end;
+    errno = 0;
+    long n = strtol(field, &end, 10);
+    if(errno != 0 || end == field || *end != '\0' || n < 1
+       || n > max_threads) {
+      fprintf(stderr, "error: sweep thread count '%s' is not in [1, %d].\n",
+              field, max_threads);
+      free(text);
+      thread_sweep_destroy(sweep);
+      return NULL;
+    }
+    sweep->threads[sweep->count++] = n;
+  }
+  free(text);
+  if(sweep->count == 0) {
+    fprintf(stderr, "error: sweep has no thread counts.\n");
+    thread_sweep_destroy(sweep);
+    return NULL;
+  }
+  return sweep;
+}
+
+void thread_sweep_destroy(thread_sweep_t *sweep) {
+  free(sweep->threads);
+  free(sweep);
+}
+
+int32_t thread_sweep_count(thread_sweep_t *sweep) {
+  return sweep->count;
+}
+
+int32_t thread_sweep_threads(thread_sweep_t *sweep, int32_t step) {
+  return sweep->threads[step];
+}
+
+int32_t thread_sweep_max(thread_sweep_t *sweep) {
+  int32_t max = 0;
+  for(int32_t i = 0; i < sweep->count; i++) {
+    if(sweep->threads[i] > max) { max = sweep->threads[i]; }
+  }
+  return max;
+}
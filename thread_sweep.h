@@ -0,0 +1,17 @@
+/* Thread-count sweeps.
+ * A sweep runs the benchmark once per thread count on the same prefilled
+ * structure, so a scaling curve pays for the prefill only once.  Counts are
+ * given as a comma-separated list, e.g. "1,2,4,9,18,36".
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+typedef struct thread_sweep_t thread_sweep_t;
+
+thread_sweep_t * thread_sweep_parse(const char *spec, int32_t max_threads);
+void thread_sweep_destroy(thread_sweep_t *sweep);
+int32_t thread_sweep_count(thread_sweep_t *sweep);
+int32_t thread_sweep_threads(thread_sweep_t *sweep, int32_t step);
+int32_t thread_sweep_max(thread_sweep_t *sweep);
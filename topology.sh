@@ -0,0 +1,83 @@
+#!/bin/bash
+
+#  Reads the machine topology from sysfs and derives the thread steps of a
+#  scaling curve.  Source it for the variables and functions below, or run
+#  it to print them.
+#
+#  SOCKETS, CORES_PER_SOCKET, THREADS_PER_CORE: the shape of the machine.
+#  SOCKET_NODES[s]: the NUMA node holding socket s (sockets in package order,
+#  the order thread_pinner fills them in).
+#  thread_steps: 1, 2, 4, ... up to a socket's cores, then for each socket
+#  the half-core, all-core and all-SMT-thread boundaries, one per line as
+#  "<threads> <nodes>", where <nodes> is the interleave set for numactl -i
+#  covering the sockets those threads are pinned to.
+#  Set SYSFS to read a copy of another machine's /sys.
+
+SOCKETS=0
+CORES_PER_SOCKET=0
+THREADS_PER_CORE=0
+SOCKET_NODES=()
+
+read_topology() {
+  local cpu pkg core node packages="" cores="" cpus=0
+  declare -A node_of
+  for cpu in ${SYSFS:-/sys}/devices/system/cpu/cpu[0-9]*; do
+    if [ -f $cpu/online ] && [ "$(cat $cpu/online)" = "0" ]; then
+      continue
+    fi
+    pkg=$(cat $cpu/topology/physical_package_id)
+    core=$(cat $cpu/topology/core_id)
+    node=0
+    for link in $cpu/node[0-9]*; do
+      [ -e "$link" ] && node=${link##*/node}
+    done
+    packages="$packages $pkg"
+    cores="$cores $pkg:$core"
+    node_of[$pkg]=$node
+    cpus=$((cpus + 1))
+  done
+  packages=$(echo $packages | tr ' ' '\n' | sort -n | uniq)
+  SOCKETS=$(echo "$packages" | wc -l)
+  local unique_cores=$(echo $cores | tr ' ' '\n' | sort -u | wc -l)
+  CORES_PER_SOCKET=$((unique_cores / SOCKETS))
+  THREADS_PER_CORE=$((cpus / unique_cores))
+  SOCKET_NODES=()
+  for pkg in $packages; do
+    SOCKET_NODES+=(${node_of[$pkg]})
+  done
+}
+
+#  $1 is a thread count; prints the interleave set for its sockets.
+nodes_for() {
+  local per_socket=$((CORES_PER_SOCKET * THREADS_PER_CORE))
+  local used=$(( ($1 + per_socket - 1) / per_socket ))
+  echo ${SOCKET_NODES[@]:0:$used} | tr ' ' '\n' | awk '!seen[$0]++' | paste -sd,
+}
+
+thread_steps() {
+  local per_socket=$((CORES_PER_SOCKET * THREADS_PER_CORE))
+  local steps="" t=1 s base
+  while [ $t -lt $CORES_PER_SOCKET ]; do
+    steps="$steps $t"
+    t=$((t * 2))
+  done
+  for ((s = 0; s < SOCKETS; s++)); do
+    base=$((s * per_socket))
+    if [ $s -gt 0 ] && [ $CORES_PER_SOCKET -gt 1 ]; then
+      steps="$steps $((base + CORES_PER_SOCKET / 2))"
+    fi
+    steps="$steps $((base + CORES_PER_SOCKET)) $((base + per_socket))"
+  done
+  for t in $(echo $steps | tr ' ' '\n' | sort -n | uniq); do
+    echo "$t $(nodes_for $t)"
+  done
+}
+
+read_topology
+
+if [ "${BASH_SOURCE[0]}" = "$0" ]; then
+  echo "sockets: $SOCKETS, cores per socket: $CORES_PER_SOCKET, threads per core: $THREADS_PER_CORE"
+  echo "socket nodes: ${SOCKET_NODES[*]}"
+  echo "thread steps (threads nodes):"
+  thread_steps
+fi
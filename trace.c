@@ -0,0 +1,161 @@
+#include "trace.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define TRACE_MAGIC "DEFTRACE"
+#define TRACE_VERSION 1
+
+typedef struct header_t header_t;
+
+struct header_t {
+  char magic[8];
+  uint32_t version, thread_count;
+  // Followed by thread_count stream lengths, then the streams themselves.
+};
+
+struct trace_stream_t {
+  uint64_t *entries;
+  uint64_t length, capacity;
+};
+
+struct trace_t {
+  int32_t thread_count;
+  trace_stream_t *streams;
+  void *mapping;
+  size_t mapping_size;
+};
+
+trace_t * trace_create(int32_t thread_count) {
+  trace_t *trace = malloc(sizeof(trace_t));
+  trace->thread_count = thread_count;
+  trace->streams = calloc(thread_count, sizeof(trace_stream_t));
+  trace->mapping = NULL;
+  trace->mapping_size = 0;
+  return trace;
+}
+
+/** Map a trace written by trace_write.  Return NULL, after printing why, if
+ *  the file is missing, truncated or not a trace.
+ */
+trace_t * trace_open(const char *path) {
+  int fd = open(path, O_RDONLY);
+  if(fd < 0) {
+    fprintf(stderr, "error: cannot open trace %s.\n", path);
+    return NULL;
+  }
+  struct stat st;
+  if(fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(header_t)) {
+    fprintf(stderr, "error: trace %s is truncated.\n", path);
+    close(fd);
+    return NULL;
+  }
+  void *mapping = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if(mapping == MAP_FAILED) {
+    fprintf(stderr, "error: cannot map trace %s.\n", path);
+    return NULL;
+  }
+  madvise(mapping, st.st_size, MADV_SEQUENTIAL);
+
+  header_t *header = mapping;
+  uint64_t *lengths = (uint64_t*)(header + 1);
+  size_t offset = sizeof(header_t);
+  if(memcmp(header->magic, TRACE_MAGIC, sizeof(header->magic)) != 0
+    || header->version != TRACE_VERSION || header->thread_count == 0) {
+    fprintf(stderr, "error: %s is not a version %d trace.\n", path,
+            TRACE_VERSION);
+    munmap(mapping, st.st_size);
+    return NULL;
+  }
+  offset += sizeof(uint64_t) * header->thread_count;
+  trace_t *trace = trace_create(header->thread_count);
+  trace->mapping = mapping;
+  trace->mapping_size = st.st_size;
+  for(uint32_t i = 0; i < header->thread_count; i++) {
+    trace_stream_t *stream = &trace->streams[i];
+    if(offset > (size_t)st.st_size || lengths[i] == 0
+      || lengths[i] > ((size_t)st.st_size - offset) / sizeof(uint64_t)) {
+      fprintf(stderr, "error: trace %s has an empty or truncated stream.\n",
+              path);
+      trace_destroy(trace);
+      return NULL;
+    }
+    stream->entries = (uint64_t*)((char*)mapping + offset);
+    stream->length = stream->capacity = lengths[i];
+    offset += sizeof(uint64_t) * lengths[i];
+  }
+  return trace;
+}
+
+int trace_write(trace_t *trace, const char *path) {
+  FILE *file = fopen(path, "wb");
+  if(file == NULL) { return -1; }
+  header_t header;
+  memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+  header.version = TRACE_VERSION;
+  header.thread_count = trace->thread_count;
+  fwrite(&header, sizeof(header), 1, file);
+  for(int32_t i = 0; i < trace->thread_count; i++) {
+    fwrite(&trace->streams[i].length, sizeof(uint64_t), 1, file);
+  }
+  for(int32_t i = 0; i < trace->thread_count; i++) {
+    trace_stream_t *stream = &trace->streams[i];
+    fwrite(stream->entries, sizeof(uint64_t), stream->length, file);
+  }
+  return fclose(file) == 0 ? 0 : -1;
+}
+
+void trace_destroy(trace_t *trace) {
+  if(trace->mapping != NULL) {
+    munmap(trace->mapping, trace->mapping_size);
+  } else {
+    for(int32_t i = 0; i < trace->thread_count; i++) {
+      free(trace->streams[i].entries);
+    }
+  }
+  free(trace->streams);
+  free(trace);
+}
+
+int32_t trace_thread_count(trace_t *trace) {
+  return trace->thread_count;
+}
+
+/** Return the stream for thread id.  Replaying with more threads than were
+ *  recorded wraps around the recorded streams.
+ */
+trace_stream_t * trace_stream(trace_t *trace, int32_t id) {
+  return &trace->streams[id % trace->thread_count];
+}
+
+void trace_stream_append(trace_stream_t *stream, uint64_t op, int64_t key) {
+  if(stream->length == stream->capacity) {
+    stream->capacity = stream->capacity == 0 ? 4096 : stream->capacity * 2;
+    stream->entries = realloc(stream->entries,
+                              sizeof(uint64_t) * stream->capacity);
+  }
+  stream->entries[stream->length++] =
+    (op << TRACE_OP_SHIFT) | ((uint64_t)key & TRACE_KEY_MASK);
+}
+
+/** Remove the last appended entry, for an operation that was drawn but
+ *  never issued.
+ */
+void trace_stream_drop_last(trace_stream_t *stream) {
+  if(stream->length > 0) {
+    stream->length--;
+  }
+}
+
+uint64_t * trace_stream_entries(trace_stream_t *stream) {
+  return stream->entries;
+}
+
+uint64_t trace_stream_length(trace_stream_t *stream) {
+  return stream->length;
+}
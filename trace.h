@@ -0,0 +1,28 @@
+/* Operation traces for deterministic record and replay.
+ * A trace holds one stream per thread; each entry packs the operation code
+ * into the top two bits and the key into the low 62 bits of a u64.  Traces
+ * are written as a small header followed by the raw streams and are
+ * memory-mapped for replay.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#define TRACE_KEY_MASK 0x3FFFFFFFFFFFFFFFULL
+#define TRACE_OP_SHIFT 62
+
+typedef struct trace_t trace_t;
+typedef struct trace_stream_t trace_stream_t;
+
+trace_t * trace_create(int32_t thread_count);
+trace_t * trace_open(const char *path);
+int trace_write(trace_t *trace, const char *path);
+void trace_destroy(trace_t *trace);
+int32_t trace_thread_count(trace_t *trace);
+
+trace_stream_t * trace_stream(trace_t *trace, int32_t id);
+void trace_stream_append(trace_stream_t *stream, uint64_t op, int64_t key);
+void trace_stream_drop_last(trace_stream_t *stream);
+uint64_t * trace_stream_entries(trace_stream_t *stream);
+uint64_t trace_stream_length(trace_stream_t *stream);
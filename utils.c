@@ -1,5 +1,12 @@
 #include "utils.h"
+#include <time.h>
 
 uint64_t* fetch_and_or(uint64_t* ptr, uint64_t mark) {
   return (uint64_t*)__sync_fetch_and_or(ptr, mark);
+}
+
+uint64_t clock_ns() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
 }
\ No newline at end of file
@@ -2,4 +2,5 @@
 
 #include <stdint.h>
 
-uint64_t* fetch_and_or(uint64_t *, uint64_t);
\ No newline at end of file
+uint64_t* fetch_and_or(uint64_t *, uint64_t);
+uint64_t clock_ns();
\ No newline at end of file